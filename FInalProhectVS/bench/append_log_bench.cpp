@@ -0,0 +1,108 @@
+//
+// Created by user on 10/18/2026.
+//
+// Cost of one watch list click at 100, 1000 and 10000 movies: rewriting the whole users/<name>.txt
+// through a temporary file and a rename, as before the journal, against appending one record to the
+// AppendLog journal. Then replays the journal and replays it again after a deliberately torn write.
+// The line formats are the ones main.cpp used for users/<name>.txt and .log before the key-value store.
+// Files go to a directory under the system temp directory that is removed at the end.
+// Build and run from this directory: g++ -std=c++20 -O2 -I../include append_log_bench.cpp && ./a.out
+
+#include <append_log.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#define CLICKS 200
+
+namespace fs = std::filesystem;
+
+struct Entry {
+    std::string id, title, year;
+};
+
+std::vector<Entry> MakeList(int count) {
+    std::vector<Entry> list;
+    for (int i = 0; i < count; ++i) {
+        char id[16];
+        std::snprintf(id, sizeof(id), "tt%07d", i);
+        list.push_back({ id, "Synthetic Movie Title " + std::to_string(i), std::to_string(1950 + i % 75) });
+    }
+    return list;
+}
+
+// the old save: every line to <name>.txt.tmp, then renamed over the snapshot; returns the bytes written
+std::uintmax_t RewriteList(const fs::path& path, const std::vector<Entry>& list) {
+    fs::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        for (const auto& entry : list) out << entry.id << '|' << entry.title << '|' << entry.year << '\n';
+    }
+    std::uintmax_t bytes = fs::file_size(tmp);
+    fs::rename(tmp, path);
+    return bytes;
+}
+
+template <typename Fn>
+double Microseconds(Fn fn) {
+    auto started = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+}
+
+int main() {
+    fs::path dir = fs::temp_directory_path() / "append_log_bench";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    std::printf("%d clicks per list size, alternating add and remove of one movie\n", CLICKS);
+    for (int count : { 100, 1000, 10000 }) {
+        std::vector<Entry> list = MakeList(count);
+        Entry extra = { "tt9999999", "One More Movie", "2024" };
+
+        std::uintmax_t rewrite_bytes = 0;
+        double rewrite_us = Microseconds([&] {
+            for (int click = 0; click < CLICKS; ++click) {
+                if (click % 2 == 0) list.push_back(extra);
+                else list.pop_back();
+                rewrite_bytes += RewriteList(dir / "user.txt", list);
+            }
+        });
+
+        AppendLog log;
+        log.open(dir / "user.log");
+        log.clear();
+        double journal_us = Microseconds([&] {
+            for (int click = 0; click < CLICKS; ++click) {
+                if (click % 2 == 0) log.append("A|" + extra.id + "|" + extra.title + "|" + extra.year);
+                else log.append("R|" + extra.id);
+            }
+        });
+
+        std::printf("%5d movies: rewrite %7.1f us / %6.1f KB per click, journal %5.1f us / %3llu B per click\n", count,
+            rewrite_us / CLICKS, rewrite_bytes / 1024.0 / CLICKS, journal_us / CLICKS, log.statistics().bytes / CLICKS);
+    }
+
+    AppendLog log;
+    log.open(dir / "user.log");
+    std::size_t replayed = 0;
+    double replay_us = Microseconds([&] { replayed = log.replay([](const std::string&) {}); });
+    std::printf("replaying %zu records: %.1f us\n", replayed, replay_us);
+
+    {
+        std::ofstream torn(dir / "user.log", std::ios::binary | std::ios::app);
+        torn << "0badc0de A|tt12"; // a write cut short by a crash
+    }
+    std::uintmax_t torn_size = fs::file_size(dir / "user.log");
+    std::size_t kept = log.replay([](const std::string&) {});
+    std::printf("after a torn write: %zu records kept, file cut from %ju to %ju bytes\n", kept, torn_size, fs::file_size(dir / "user.log"));
+    bool ok = replayed == CLICKS && kept == CLICKS;
+
+    fs::remove_all(dir);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+//
+// Created by user on 10/18/2026.
+//
+// JPEG decode throughput of the two stb_image builds behind image_decode.h: the scalar one
+// (STBI_NO_SIMD) against the SIMD kernels DecodeImage picks at runtime. Decodes each file to RGBA like
+// the poster pipeline, defaults to the bundled images/AGM.jpg, and reports compressed MB/s and
+// megapixels/s plus the largest channel difference between the two outputs.
+// Build and run from this directory:
+// g++ -std=c++20 -O2 -I../include -I../include/stb jpeg_decode_bench.cpp ../src/image_decode.cpp ../src/image_decode_scalar.cpp && ./a.out [files]
+
+#include <image_decode.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#define SECONDS_PER_PATH 1.0
+
+struct Result {
+    double mb_per_s = 0;
+    double megapixels_per_s = 0;
+};
+
+Result Measure(const std::vector<unsigned char>& file, DecodePath path, std::vector<unsigned char>& pixels) {
+    int width = 0, height = 0, channels = 0;
+    int decodes = 0;
+    auto started = std::chrono::steady_clock::now();
+    double seconds = 0;
+    while (seconds < SECONDS_PER_PATH) {
+        unsigned char* data = DecodeImage(file.data(), (int)file.size(), &width, &height, &channels, 4, path);
+        if (data == nullptr) {
+            std::printf("decode failed: %s\n", DecodeFailureReason(path));
+            std::exit(1);
+        }
+        if (decodes == 0) pixels.assign(data, data + (std::size_t)width * height * 4);
+        FreeDecodedImage(data);
+        decodes++;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+    return { decodes * file.size() / 1e6 / seconds, decodes * (double)width * height / 1e6 / seconds };
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) files.push_back(argv[i]);
+    if (files.empty()) files.push_back("../images/AGM.jpg");
+
+    std::printf("SIMD kernels %s on this CPU (%s)\n", SimdDecodeAvailable() ? "available" : "not available",
+        DecodePathName(DecodePath::Simd));
+    int status = 0;
+    for (const auto& name : files) {
+        std::ifstream in(name, std::ios::binary);
+        std::vector<unsigned char> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (file.empty()) {
+            std::printf("%s: cannot read\n", name.c_str());
+            status = 1;
+            continue;
+        }
+        std::vector<unsigned char> scalar_pixels, simd_pixels;
+        Result scalar = Measure(file, DecodePath::Scalar, scalar_pixels);
+        Result simd = Measure(file, DecodePath::Simd, simd_pixels);
+        int max_difference = 0;
+        for (std::size_t i = 0; i < std::min(scalar_pixels.size(), simd_pixels.size()); ++i) {
+            max_difference = std::max(max_difference, std::abs(scalar_pixels[i] - simd_pixels[i]));
+        }
+        std::printf("%s (%zu KB)\n", name.c_str(), file.size() / 1024);
+        std::printf("  scalar %7.1f MB/s %7.1f Mpixel/s\n", scalar.mb_per_s, scalar.megapixels_per_s);
+        std::printf("  %-6s %7.1f MB/s %7.1f Mpixel/s (%.2fx), max channel difference %d\n", DecodePathName(DecodePath::Simd),
+            simd.mb_per_s, simd.megapixels_per_s, simd.mb_per_s / scalar.mb_per_s, max_difference);
+    }
+    return status;
+}
@@ -0,0 +1,105 @@
+//
+// Created by user on 10/18/2026.
+//
+// The user store workload on KvStore: many users, one long watch list and the movie records it shows,
+// using main.cpp's key layout (user/<name>, watch/<name>/<16 hex position>, movie/<id>). Times the
+// durable puts, open and replay, a login lookup, loading the long list with its metadata, scanning an
+// empty list and compacting after half the list is erased. The default sizes are a tenth of the
+// original run; pass a scale factor to change them. The store goes to a directory under the system
+// temp directory that is removed at the end.
+// Build and run from this directory: g++ -std=c++20 -O2 -I../include kv_store_bench.cpp && ./a.out [scale]
+
+#include <kv_store.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+template <typename Fn>
+double Milliseconds(Fn fn) {
+    auto started = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+}
+
+std::string Position(long long position) {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", position);
+    return hex;
+}
+
+std::string MovieId(long long index) {
+    char id[24];
+    std::snprintf(id, sizeof(id), "tt%07lld", index);
+    return id;
+}
+
+int main(int argc, char** argv) {
+    double scale = argc > 1 ? std::atof(argv[1]) : 1.0;
+    long long users = (long long)(10000 * scale);
+    long long list = (long long)(100000 * scale);
+    fs::path dir = fs::temp_directory_path() / "kv_store_bench";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    fs::path path = dir / "users.db";
+
+    KvStore store;
+    store.open(path);
+    double write_ms = Milliseconds([&] {
+        for (long long i = 0; i < users; ++i) store.put("user/user" + std::to_string(i), "");
+        for (long long i = 0; i < list; ++i) {
+            std::string id = MovieId(i);
+            store.put("movie/" + id, std::to_string(1950 + i % 75) + "|https://m.media-amazon.com/images/M/" + id + "._V1_SX300.jpg|Synthetic Movie Title " + std::to_string(i));
+            store.put("watch/collector/" + Position(i), id);
+        }
+    });
+    long long records = users + 2 * list;
+    std::printf("%lld users, one %lld entry list, %lld movie records: %lld records, %.1f MB\n",
+        users, list, list, records, fs::file_size(path) / 1e6);
+    std::printf("writing               %9.1f ms (%.2f us per durable put)\n", write_ms, write_ms * 1000 / records);
+
+    KvStore reopened;
+    double open_ms = Milliseconds([&] { reopened.open(path); });
+    std::printf("open and replay       %9.1f ms\n", open_ms);
+
+    const int lookups = 100000;
+    int found = 0;
+    std::string value;
+    double lookup_ms = Milliseconds([&] {
+        for (int i = 0; i < lookups; ++i) found += reopened.get("user/user" + std::to_string(i % users), value);
+    });
+    std::printf("login lookup          %9.3f us\n", lookup_ms * 1000 / lookups);
+
+    long long loaded = 0;
+    double load_ms = Milliseconds([&] {
+        reopened.scan("watch/collector/", [&](const std::string&, const std::string& id) {
+            std::string movie;
+            if (reopened.get("movie/" + id, movie)) loaded++;
+        });
+    });
+    std::printf("load the long list    %9.1f ms (%lld entries with metadata)\n", load_ms, loaded);
+
+    const int scans = 100000;
+    int empty_rows = 0;
+    double empty_ms = Milliseconds([&] {
+        for (int i = 0; i < scans; ++i) {
+            reopened.scan("watch/user" + std::to_string(i % users) + "/", [&](const std::string&, const std::string&) { empty_rows++; });
+        }
+    });
+    std::printf("empty list scan       %9.3f us\n", empty_ms * 1000 / scans);
+
+    for (long long i = 0; i < list; i += 2) reopened.erase("watch/collector/" + Position(i));
+    std::uintmax_t before = fs::file_size(path);
+    bool compacted = false;
+    double compact_ms = Milliseconds([&] { compacted = reopened.compact(); });
+    std::printf("compact               %9.1f ms (after %lld erases, %.1f MB to %.1f MB)\n", compact_ms, (list + 1) / 2,
+        before / 1e6, fs::file_size(path) / 1e6);
+
+    bool ok = found == lookups && loaded == list && empty_rows == 0 && compacted;
+    fs::remove_all(dir);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+//
+// Created by user on 10/18/2026.
+//
+// Memory and sort / filter cost of the compact Movie record against the all-strings record it
+// replaced, on synthetic OMDb-like data. The compact record and its parsing come from movie.h, the
+// old record is kept here as it was in main.cpp before the change.
+// Build and run from this directory: g++ -std=c++20 -O2 -I../include movie_record_bench.cpp && ./a.out [records]
+
+#include <movie.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// GCC sees the free below inlined next to library operator new calls and cannot tell they are these
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// live heap bytes, every block carries its size in front
+std::size_t live_bytes = 0;
+
+void* operator new(std::size_t size) {
+    void* block = std::malloc(size + 16);
+    if (block == nullptr) throw std::bad_alloc();
+    *static_cast<std::size_t*>(block) = size;
+    live_bytes += size;
+    return static_cast<char*>(block) + 16;
+}
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) return;
+    void* block = static_cast<char*>(ptr) - 16;
+    live_bytes -= *static_cast<std::size_t*>(block);
+    std::free(block);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+struct OldMovie {
+    std::string id;
+    std::string title;
+    std::string producer;
+    std::string release_year;
+    std::string runtime;
+    std::vector<std::string> genres;
+    std::vector<std::string> cast;
+    std::string poster_url;
+    unsigned int texture_id = 0;
+    std::string rating;
+    std::string votes;
+    bool in_watch_list = false;
+    bool details_loaded = false;
+};
+
+const char* genre_names[] = { "Action", "Adventure", "Animation", "Comedy", "Crime", "Drama", "Family", "Fantasy",
+    "History", "Horror", "Music", "Mystery", "Romance", "Sci-Fi", "Thriller", "War", "Western" };
+
+struct Source { // one synthetic OMDb answer
+    std::string id, title, director, year, runtime, rating, votes, poster;
+    std::vector<std::string> genres, cast;
+    std::string genre_list, cast_list; // the same, comma separated like OMDb sends them
+};
+
+Source MakeSource(std::mt19937& random, int index) {
+    Source source;
+    char id[16];
+    std::snprintf(id, sizeof(id), "tt%07d", index);
+    source.id = id;
+    source.title = "Synthetic Movie Title Number " + std::to_string(index);
+    source.director = "Director " + std::to_string(random() % 20000);
+    int year = 1920 + (int)(random() % 105);
+    source.year = std::to_string(year);
+    source.runtime = std::to_string(70 + random() % 110) + " min";
+    char rating[8];
+    std::snprintf(rating, sizeof(rating), "%d.%d", 1 + (int)(random() % 9), (int)(random() % 10));
+    source.rating = rating;
+    source.votes = std::to_string(random() % 900) + "," + std::to_string(100 + random() % 900);
+    source.poster = "https://m.media-amazon.com/images/M/MV5B" + std::to_string(random()) + "._V1_SX300.jpg";
+    for (int i = 0; i < 3; ++i) source.genres.push_back(genre_names[random() % 17]);
+    for (int i = 0; i < 4; ++i) source.cast.push_back("Actor " + std::to_string(random() % 30000));
+    for (const auto& genre : source.genres) source.genre_list += (source.genre_list.empty() ? "" : ", ") + genre;
+    for (const auto& actor : source.cast) source.cast_list += (source.cast_list.empty() ? "" : ", ") + actor;
+    return source;
+}
+
+OldMovie MakeOld(const Source& source) {
+    OldMovie movie;
+    movie.id = source.id;
+    movie.title = source.title;
+    movie.producer = source.director;
+    movie.release_year = source.year;
+    movie.runtime = source.runtime;
+    movie.genres = source.genres;
+    movie.cast = source.cast;
+    movie.poster_url = source.poster;
+    movie.rating = source.rating;
+    movie.votes = source.votes;
+    return movie;
+}
+
+Movie MakeCompact(const Source& source) { // the way FetchMovieInfo fills a record
+    Movie movie;
+    movie.id = source.id;
+    SetTitle(movie, source.title);
+    movie.poster_url = source.poster;
+    movie.director = Intern(source.director);
+    ParseYearRange(source.year, movie);
+    movie.runtime_minutes = ParseRuntime(source.runtime);
+    movie.rating_tenths = ParseRating(source.rating);
+    movie.votes = ParseVotes(source.votes);
+    movie.genre_count = InternList(source.genre_list, movie.genres, MOVIE_MAX_GENRES);
+    movie.cast_count = InternList(source.cast_list, movie.cast, MOVIE_MAX_CAST);
+    return movie;
+}
+
+template <typename Fn>
+double Milliseconds(Fn fn) {
+    auto started = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 200000;
+    std::mt19937 random(1);
+    std::vector<Source> sources;
+    sources.reserve(count);
+    for (int i = 0; i < count; ++i) sources.push_back(MakeSource(random, i));
+
+    std::size_t before = live_bytes;
+    std::vector<OldMovie> old_movies;
+    old_movies.reserve(count);
+    for (const auto& source : sources) old_movies.push_back(MakeOld(source));
+    std::size_t old_bytes = live_bytes - before;
+
+    before = live_bytes;
+    std::vector<Movie> compact_movies;
+    compact_movies.reserve(count);
+    for (const auto& source : sources) compact_movies.push_back(MakeCompact(source));
+    std::size_t compact_bytes = live_bytes - before;
+    StringPool::Statistics pool = StringPool::instance().statistics();
+
+    std::printf("%d records\n", count);
+    std::printf("sizeof                     old %4zu B, compact %4zu B\n", sizeof(OldMovie), sizeof(Movie));
+    std::printf("bytes per movie incl. heap old %4zu B, compact %4zu B (pool: %zu strings, %zu bytes, included)\n",
+        old_bytes / count, compact_bytes / count, pool.strings, pool.bytes);
+
+    double old_year = Milliseconds([&] {
+        std::stable_sort(old_movies.begin(), old_movies.end(), [](const OldMovie& a, const OldMovie& b) { return a.release_year < b.release_year; });
+    });
+    double compact_year = Milliseconds([&] {
+        std::stable_sort(compact_movies.begin(), compact_movies.end(), [](const Movie& a, const Movie& b) { return a.year_from < b.year_from; });
+    });
+    std::printf("stable_sort by year        old %7.1f ms, compact %7.1f ms\n", old_year, compact_year);
+
+    double old_rating = Milliseconds([&] {
+        std::stable_sort(old_movies.begin(), old_movies.end(), [](const OldMovie& a, const OldMovie& b) { return std::stod(a.rating) < std::stod(b.rating); });
+    });
+    double compact_rating = Milliseconds([&] {
+        std::stable_sort(compact_movies.begin(), compact_movies.end(), [](const Movie& a, const Movie& b) { return a.rating_tenths < b.rating_tenths; });
+    });
+    std::printf("stable_sort by rating      old %7.1f ms, compact %7.1f ms\n", old_rating, compact_rating);
+
+    std::size_t old_matches = 0, compact_matches = 0;
+    double old_filter = Milliseconds([&] {
+        for (const auto& movie : old_movies) {
+            if (std::atoi(movie.runtime.c_str()) >= 120 && std::find(movie.genres.begin(), movie.genres.end(), "Drama") != movie.genres.end()) old_matches++;
+        }
+    });
+    StringId drama = Intern("Drama");
+    double compact_filter = Milliseconds([&] {
+        for (const auto& movie : compact_movies) {
+            if (movie.runtime_minutes >= 120 && std::find(movie.genres, movie.genres + movie.genre_count, drama) != movie.genres + movie.genre_count) compact_matches++;
+        }
+    });
+    std::printf("filter genre + runtime     old %7.1f ms, compact %7.1f ms (%zu / %zu matches)\n",
+        old_filter, compact_filter, old_matches, compact_matches);
+    return old_matches == compact_matches ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+//
+// Created by user on 10/18/2026.
+//
+// MpmcRingQueue against the mutex ThreadSafeQueue at the image pipeline's stage capacity: n producers
+// and n consumers pass 200k strings through a 64 slot queue.
+// Build and run from this directory: g++ -std=c++20 -O2 -pthread -I../include mpmc_ring_queue_bench.cpp && ./a.out
+
+#include <mpmc_ring_queue.h>
+#include <thread_safe_queue.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define ITEMS 200000
+#define CAPACITY 64
+
+template <typename Queue>
+double Run(int threads) {
+    Queue queue(CAPACITY);
+    std::atomic<long long> consumed(0);
+    auto started = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < threads; ++i) {
+        consumers.emplace_back([&] {
+            std::string value;
+            while (queue.pop(value)) {
+                consumed++;
+            }
+        });
+    }
+    std::vector<std::thread> producers;
+    for (int i = 0; i < threads; ++i) {
+        producers.emplace_back([&, i] {
+            for (int item = i; item < ITEMS; item += threads) {
+                queue.push("https://m.media-amazon.com/images/M/poster" + std::to_string(item) + "._V1_SX300.jpg");
+            }
+        });
+    }
+    for (auto& producer : producers) producer.join();
+    queue.setFinished();
+    for (auto& consumer : consumers) consumer.join();
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    if (consumed.load() != ITEMS) {
+        std::printf("lost items: %lld of %d\n", consumed.load(), ITEMS);
+    }
+    return ms;
+}
+
+int main() {
+    std::printf("%d strings through a %d slot queue, %u hardware threads\n", ITEMS, CAPACITY, std::thread::hardware_concurrency());
+    std::printf("%-22s %12s %12s\n", "producers/consumers", "mutex ms", "ring ms");
+    for (int threads : { 1, 2, 4, 8, 16 }) {
+        double mutex_ms = Run<ThreadSafeQueue<std::string>>(threads);
+        double ring_ms = Run<MpmcRingQueue<std::string>>(threads);
+        std::printf("%-22d %12.1f %12.1f\n", threads, mutex_ms, ring_ms);
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+//
+// Created by user on 10/18/2026.
+//
+// How long urgent work waits behind a backlog: 4 producers keep about 5000 low priority items queued,
+// one consumer spends 20 us per item, and a high priority item arrives every 5 ms. Compares
+// PriorityThreadSafeQueue (with the pipeline's 250 ms aging) against the FIFO ThreadSafeQueue.
+// Build and run from this directory: g++ -std=c++20 -O2 -pthread -I../include priority_queue_bench.cpp && ./a.out
+
+#include <priority_thread_safe_queue.h>
+#include <thread_safe_queue.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#define BACKLOG 5000
+#define WORK_US 20
+#define URGENT_EVERY_MS 5
+#define RUN_MS 2000
+
+using Clock = std::chrono::steady_clock;
+
+struct Item {
+    bool urgent = false;
+    Clock::time_point queued;
+};
+
+struct Result {
+    std::vector<double> urgent_waits_ms;
+    long long bulk_served = 0;
+};
+
+void Spin(std::chrono::microseconds duration) {
+    auto until = Clock::now() + duration;
+    while (Clock::now() < until) {}
+}
+
+// push(queue, item) adds with the right priority, size(queue) is its depth
+template <typename Queue, typename Push>
+Result Run(Queue& queue, Push push) {
+    Result result;
+    std::atomic<bool> running(true);
+
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 4; ++i) {
+        producers.emplace_back([&] {
+            while (running) {
+                if (queue.size() < BACKLOG) push(queue, Item{ false, Clock::now() });
+                else std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        });
+    }
+    std::thread urgent([&] {
+        while (running) {
+            push(queue, Item{ true, Clock::now() });
+            std::this_thread::sleep_for(std::chrono::milliseconds(URGENT_EVERY_MS));
+        }
+    });
+    std::thread consumer([&] {
+        Item item;
+        while (queue.pop(item)) {
+            if (item.urgent) {
+                result.urgent_waits_ms.push_back(std::chrono::duration<double, std::milli>(Clock::now() - item.queued).count());
+            }
+            else {
+                result.bulk_served++;
+            }
+            Spin(std::chrono::microseconds(WORK_US));
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(RUN_MS));
+    running = false;
+    for (auto& producer : producers) producer.join();
+    urgent.join();
+    queue.setFinished();
+    consumer.join();
+    return result;
+}
+
+void Print(const char* name, Result result) {
+    std::sort(result.urgent_waits_ms.begin(), result.urgent_waits_ms.end());
+    auto percentile = [&](double p) {
+        if (result.urgent_waits_ms.empty()) return 0.0;
+        return result.urgent_waits_ms[(std::size_t)(p * (result.urgent_waits_ms.size() - 1))];
+    };
+    std::printf("%-10s urgent items %5zu, wait p50 %8.2f ms, p99 %8.2f ms; bulk items served %lld\n", name,
+        result.urgent_waits_ms.size(), percentile(0.5), percentile(0.99), result.bulk_served);
+}
+
+int main() {
+    std::printf("%d ms per run, %d bulk items kept queued, %d us per item, an urgent item every %d ms\n",
+        RUN_MS, BACKLOG, WORK_US, URGENT_EVERY_MS);
+
+    PriorityThreadSafeQueue<Item> priority_queue(2, std::chrono::milliseconds(250));
+    Print("priority", Run(priority_queue, [](auto& queue, Item item) { queue.push(item, item.urgent ? 1 : 0); }));
+
+    ThreadSafeQueue<Item> fifo;
+    Print("fifo", Run(fifo, [](auto& queue, Item item) { queue.push(item); }));
+    return 0;
+}
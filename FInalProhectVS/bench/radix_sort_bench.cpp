@@ -0,0 +1,88 @@
+//
+// Created by user on 10/18/2026.
+//
+// Sorting 100k result rows by title and by year, both directions: std::stable_sort of the rows on
+// CompareMovies against the SortRowsBy permutation the tables build (movie_sort.h). The orders must
+// match exactly, ties included.
+// Build and run from this directory: g++ -std=c++20 -O2 -I../include radix_sort_bench.cpp && ./a.out [rows]
+
+#include <movie_sort.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#define ROUNDS 5
+
+using Records = std::vector<std::shared_ptr<const Movie>>;
+
+const char* words[] = { "star", "wars", "return", "of", "the", "lord", "rings", "night", "dark", "knight",
+    "love", "story", "man", "woman", "last", "first", "day", "city", "war", "house", "blood", "ghost",
+    "summer", "winter", "secret", "life", "death", "king", "queen", "road", "home", "lost" };
+
+Records MakeRows(int count) {
+    std::mt19937 random(3);
+    Records rows;
+    rows.reserve(count);
+    for (int row = 0; row < count; ++row) {
+        Movie movie;
+        std::string title;
+        int length = 1 + (int)(random() % 4);
+        for (int i = 0; i < length; ++i) {
+            if (i > 0) title += ' ';
+            title += words[random() % 32];
+        }
+        if (random() % 4 == 0) title += " " + std::to_string(2 + random() % 5); // sequels
+        SetTitle(movie, title);
+        movie.year_from = (std::int16_t)(1920 + random() % 105);
+        movie.year_to = random() % 10 == 0 ? (std::int16_t)(movie.year_from + random() % 8) : movie.year_from;
+        rows.push_back(std::make_shared<const Movie>(std::move(movie)));
+    }
+    return rows;
+}
+
+// best of ROUNDS, every round starts from the list order
+template <typename Sort>
+double Best(std::size_t count, std::vector<std::uint32_t>& order, Sort sort) {
+    double best = 1e300;
+    for (int round = 0; round < ROUNDS; ++round) {
+        order.resize(count);
+        std::iota(order.begin(), order.end(), 0u);
+        auto started = std::chrono::steady_clock::now();
+        sort(order);
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    Records rows = MakeRows(count);
+    std::vector<std::uint32_t> expected, actual;
+    bool same = true;
+
+    std::printf("%d rows, best of %d\n", count, ROUNDS);
+    for (SortColumn column : { SortColumn::Title, SortColumn::Year }) {
+        for (bool ascending : { true, false }) {
+            double compare = Best(rows.size(), expected, [&](std::vector<std::uint32_t>& order) {
+                std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+                    int c = CompareMovies(*rows[a], *rows[b], column);
+                    return ascending ? c < 0 : c > 0;
+                });
+            });
+            double radix = Best(rows.size(), actual, [&](std::vector<std::uint32_t>& order) { SortRowsBy(rows, { column, ascending }, order); });
+            same = same && expected == actual;
+            std::printf("%-5s %-4s stable_sort %7.2f ms, radix permutation %7.2f ms\n",
+                column == SortColumn::Title ? "title" : "year", ascending ? "asc" : "desc", compare, radix);
+        }
+    }
+    std::printf("orders %s\n", same ? "identical" : "DIFFER");
+    return same ? 0 : 1;
+}
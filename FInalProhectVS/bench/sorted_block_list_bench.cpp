@@ -0,0 +1,111 @@
+//
+// Created by user on 10/18/2026.
+//
+// Streaming search results into a sorted title order one row at a time: SortedBlockList against a
+// sorted std::vector insert and against re-sorting the whole list with the radix permutation for
+// every 10 row batch, as the tables did before. Then reads a 40 row window the way the clipper does.
+// Build and run from this directory: g++ -std=c++20 -O2 -I../include sorted_block_list_bench.cpp && ./a.out [rows]
+
+#include <radix_sort.h>
+#include <sorted_block_list.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#define BATCH 10
+#define VISIBLE_ROWS 40
+
+struct Row {
+    std::string sort_title;
+    std::uint64_t title_key = 0;
+};
+
+std::vector<Row> MakeRows(int count) {
+    std::mt19937 random(5);
+    std::vector<Row> rows(count);
+    for (auto& row : rows) {
+        int length = 4 + (int)(random() % 20);
+        for (int i = 0; i < length; ++i) row.sort_title += (char)('a' + random() % 26);
+        for (std::size_t i = 0; i < 8; ++i) {
+            row.title_key = (row.title_key << 8) | (i < row.sort_title.size() ? (unsigned char)row.sort_title[i] : 0);
+        }
+    }
+    return rows;
+}
+
+template <typename Fn>
+double Milliseconds(Fn fn) {
+    auto started = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::vector<Row> rows = MakeRows(count);
+    // like RowLess: the sort key, then the row index so equal titles keep their arrival order
+    auto less = [&](std::uint32_t a, std::uint32_t b) {
+        if (rows[a].title_key != rows[b].title_key) return rows[a].title_key < rows[b].title_key;
+        int c = rows[a].sort_title.compare(rows[b].sort_title);
+        return c != 0 ? c < 0 : a < b;
+    };
+
+    SortedBlockList<std::uint32_t> blocks;
+    double block_ms = Milliseconds([&] {
+        for (std::uint32_t row = 0; row < (std::uint32_t)count; ++row) blocks.insert(row, less);
+    });
+
+    std::vector<std::uint32_t> sorted;
+    double vector_ms = Milliseconds([&] {
+        for (std::uint32_t row = 0; row < (std::uint32_t)count; ++row) {
+            sorted.insert(std::lower_bound(sorted.begin(), sorted.end(), row, less), row);
+        }
+    });
+
+    std::vector<std::uint32_t> order;
+    std::vector<std::uint64_t> keys;
+    double resort_ms = Milliseconds([&] {
+        for (std::size_t size = BATCH; size <= (std::size_t)count; size += BATCH) {
+            keys.resize(size);
+            for (std::size_t i = size - BATCH; i < size; ++i) keys[i] = rows[i].title_key;
+            order.resize(size);
+            std::iota(order.begin(), order.end(), 0u);
+            RadixSortIndices(keys, order);
+            for (std::size_t first = 0; first < order.size();) {
+                std::size_t last = first + 1;
+                while (last < order.size() && keys[order[last]] == keys[order[first]]) ++last;
+                if (last - first > 1) std::stable_sort(order.begin() + first, order.begin() + last, less);
+                first = last;
+            }
+        }
+    });
+
+    bool same = blocks.size() == sorted.size();
+    for (std::size_t i = 0; same && i < sorted.size(); ++i) same = blocks[i] == sorted[i];
+    same = same && order == std::vector<std::uint32_t>(sorted.begin(), sorted.begin() + order.size());
+
+    std::mt19937 random(9);
+    unsigned long long checksum = 0;
+    const int frames = 10000;
+    double window_ms = Milliseconds([&] {
+        for (int frame = 0; frame < frames; ++frame) {
+            std::size_t first = random() % (blocks.size() - VISIBLE_ROWS);
+            for (std::size_t i = first; i < first + VISIBLE_ROWS; ++i) checksum += blocks[i];
+        }
+    });
+
+    std::printf("%d rows streamed one at a time\n", count);
+    std::printf("block list                      %9.1f ms total, %6.2f us per row\n", block_ms, block_ms * 1000 / count);
+    std::printf("sorted std::vector insert       %9.1f ms total, %6.2f us per row\n", vector_ms, vector_ms * 1000 / count);
+    std::printf("radix re-sort per %d row batch  %9.1f ms total\n", BATCH, resort_ms);
+    std::printf("%d visible rows per frame        %9.3f us per frame (checksum %llu)\n", VISIBLE_ROWS, window_ms * 1000 / frames, checksum);
+    std::printf("orders %s\n", same ? "identical" : "DIFFER");
+    return same ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_APPEND_LOG_H
+#define FINALPROJECT_APPEND_LOG_H
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+// CRC-32 (IEEE, the zlib one) of data
+inline std::uint32_t Crc32(const std::string& data) {
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> t{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int bit = 0; bit < 8; ++bit) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (unsigned char byte : data) crc = table[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// A file of records that only ever grows at the end, one line per record: the CRC-32 of the payload
+// in hex, a space, the payload. Appending costs the record, not the file. A crash can only tear the
+// last record; replay stops at the first record whose checksum does not match and cuts the file
+// there, so later appends are not hidden behind the torn one. Payloads must not contain '\n'.
+// Not thread safe, the owner serializes the calls.
+class AppendLog {
+public:
+    struct Statistics {
+        unsigned long long appended = 0; // records
+        unsigned long long bytes = 0;
+        unsigned long long replayed = 0;
+        unsigned long long dropped = 0; // torn or corrupt tails cut by replay
+        unsigned long long cleared = 0;
+    };
+
+    const std::filesystem::path& path() const {
+        return file_path;
+    }
+
+    // switches to the log at path; records() is unknown until replay
+    void open(const std::filesystem::path& path) {
+        out.close();
+        file_path = path;
+        record_count = 0;
+    }
+
+    // calls fn(payload) for every intact record from the start, returns how many there were
+    template <typename Fn>
+    std::size_t replay(Fn fn) {
+        out.close();
+        record_count = 0;
+        std::ifstream in(file_path, std::ios::binary);
+        if (!in.is_open()) return 0;
+
+        std::uintmax_t good_bytes = 0;
+        bool torn = false;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (in.eof() || line.size() < 9 || line[8] != ' ') { // no newline: the write was cut short
+                torn = true;
+                break;
+            }
+            std::string payload = line.substr(9);
+            unsigned long crc = 0;
+            if (std::sscanf(line.c_str(), "%8lx", &crc) != 1 || (std::uint32_t)crc != Crc32(payload)) {
+                torn = true;
+                break;
+            }
+            fn(payload);
+            good_bytes += line.size() + 1;
+            record_count++;
+        }
+        if (!torn && !in.eof()) torn = true;
+        in.close();
+        stats.replayed += record_count;
+        if (torn) {
+            std::error_code ec;
+            if (std::filesystem::file_size(file_path, ec) > good_bytes) {
+                std::filesystem::resize_file(file_path, good_bytes, ec);
+                stats.dropped++;
+            }
+        }
+        return record_count;
+    }
+
+    // writes payload at the end of the log and hands it to the OS; false if the file could not be written
+    bool append(const std::string& payload) {
+        if (!out.is_open()) {
+            out.open(file_path, std::ios::binary | std::ios::app);
+            if (!out.is_open()) return false;
+        }
+        char crc[10];
+        std::snprintf(crc, sizeof(crc), "%08lx ", (unsigned long)Crc32(payload));
+        out.write(crc, 9);
+        out.write(payload.data(), (std::streamsize)payload.size());
+        out.put('\n');
+        out.flush();
+        if (!out) {
+            out.close();
+            return false;
+        }
+        record_count++;
+        stats.appended++;
+        stats.bytes += 9 + payload.size() + 1;
+        return true;
+    }
+
+    // closes the file, e.g. before it is renamed; the next append opens it again
+    void close() {
+        out.close();
+    }
+
+    // empties the log, once its records are part of a snapshot
+    void clear() {
+        out.close();
+        std::ofstream(file_path, std::ios::binary | std::ios::trunc);
+        record_count = 0;
+        stats.cleared++;
+    }
+
+    // records in the log, counting the replayed ones
+    std::size_t records() const {
+        return record_count;
+    }
+
+    Statistics statistics() const {
+        return stats;
+    }
+
+private:
+    std::filesystem::path file_path;
+    std::ofstream out; // kept open between appends
+    std::size_t record_count = 0;
+    Statistics stats;
+};
+
+#endif //FINALPROJECT_APPEND_LOG_H
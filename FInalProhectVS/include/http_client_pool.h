@@ -0,0 +1,216 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_HTTP_CLIENT_POOL_H
+#define FINALPROJECT_HTTP_CLIENT_POOL_H
+
+#pragma once
+
+#include <map>
+#include <cctype>
+#include <memory>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <httplib.h>
+
+struct ParsedUrl {
+    std::string scheme;
+    std::string host;
+    int port = 0;
+    std::string path; // path and query, at least "/"
+
+    std::string origin() const {
+        return scheme + "://" + host + ":" + std::to_string(port);
+    }
+};
+
+inline bool ParseUrl(const std::string& url, ParsedUrl& parsed) {
+    std::size_t scheme_end = url.find("://");
+    if (scheme_end == std::string::npos) return false;
+    parsed.scheme = url.substr(0, scheme_end);
+    for (auto& c : parsed.scheme) c = (char)tolower((unsigned char)c);
+    if (parsed.scheme != "http" && parsed.scheme != "https") return false;
+
+    std::size_t host_start = scheme_end + 3;
+    std::size_t path_start = url.find_first_of("/?#", host_start);
+    std::string authority = url.substr(host_start, path_start == std::string::npos ? std::string::npos : path_start - host_start);
+    std::size_t at = authority.rfind('@'); // drop user info
+    if (at != std::string::npos) authority = authority.substr(at + 1);
+    if (authority.empty()) return false;
+
+    std::size_t colon = authority.rfind(':');
+    if (colon != std::string::npos && authority.find(']', colon) == std::string::npos) {
+        parsed.host = authority.substr(0, colon);
+        try {
+            parsed.port = std::stoi(authority.substr(colon + 1));
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+    }
+    else {
+        parsed.host = authority;
+        parsed.port = parsed.scheme == "https" ? 443 : 80;
+    }
+    parsed.path = path_start == std::string::npos ? "/" : url.substr(path_start);
+    if (parsed.path[0] != '/') parsed.path = "/" + parsed.path;
+    std::size_t fragment = parsed.path.find('#');
+    if (fragment != std::string::npos) parsed.path.erase(fragment);
+    return !parsed.host.empty() && parsed.port > 0;
+}
+
+// resolves a redirect Location header against the url it came from
+inline std::string ResolveLocation(const ParsedUrl& base, const std::string& location) {
+    if (location.find("://") != std::string::npos) return location;
+    if (location.rfind("//", 0) == 0) return base.scheme + ":" + location;
+    if (!location.empty() && location[0] == '/') return base.origin() + location;
+    std::size_t last_slash = base.path.rfind('/', base.path.find('?'));
+    return base.origin() + base.path.substr(0, last_slash + 1) + location;
+}
+
+// Keep-alive httplib clients pooled per origin (scheme, host and port). Each client is used by one
+// thread at a time, at most max_per_origin exist per origin, and redirects are followed by hand so
+// a hop to another host goes through that host's pool as well.
+class HttpClientPool {
+public:
+    struct Timings {
+        double ttfb_ms = 0; // request sent until response headers, includes connect and TLS on a new connection
+        double total_ms = 0;
+        bool reused = false;
+        int redirects = 0;
+    };
+
+    struct OriginStatistics {
+        unsigned long long requests = 0;
+        unsigned long long new_connections = 0;
+        double ttfb_new_ms = 0; // summed, the gap to ttfb_reused_ms is the connect + TLS cost
+        double ttfb_reused_ms = 0;
+        double total_ms = 0; // summed over requests that ended at this origin
+    };
+
+    using Receiver = std::function<bool(const char* data, std::size_t length)>;
+
+    explicit HttpClientPool(std::size_t max_per_origin = 4, int max_redirects = 5)
+        : max_per_origin(max_per_origin), max_redirects(max_redirects) {}
+
+    // streams the body of a 200 response into receiver, status is the final status (0 without a response)
+    bool get(const std::string& url, const httplib::Headers& headers, const Receiver& receiver, int& status, Timings& timings) {
+        status = 0;
+        timings = Timings();
+        auto started = std::chrono::steady_clock::now();
+        std::string current = url;
+
+        for (int hop = 0; hop <= max_redirects; ++hop) {
+            ParsedUrl parsed;
+            if (!ParseUrl(current, parsed)) return false;
+
+            bool reused = false;
+            std::unique_ptr<httplib::Client> client = acquire(parsed.origin(), reused);
+            auto sent = std::chrono::steady_clock::now();
+            double ttfb_ms = 0;
+            int hop_status = 0;
+            auto res = client->Get(parsed.path, headers,
+                [&](const httplib::Response& response) {
+                    ttfb_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sent).count();
+                    hop_status = response.status;
+                    return true;
+                },
+                [&](const char* data, std::size_t length) {
+                    return hop_status != 200 || receiver(data, length); // a redirect body is read and dropped
+                });
+            release(parsed.origin(), std::move(client), static_cast<bool>(res));
+            if (!res) return false;
+            record_hop(parsed.origin(), reused, ttfb_ms);
+
+            status = res->status;
+            timings.reused = hop == 0 ? reused : timings.reused;
+            timings.ttfb_ms += ttfb_ms;
+            if (status >= 300 && status < 400 && res->has_header("Location")) {
+                current = ResolveLocation(parsed, res->get_header_value("Location"));
+                timings.redirects++;
+                continue;
+            }
+            timings.total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+            record_total(parsed.origin(), timings.total_ms);
+            return status == 200;
+        }
+        return false;
+    }
+
+    std::map<std::string, OriginStatistics> statistics() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+private:
+    struct Origin {
+        std::vector<std::unique_ptr<httplib::Client>> idle;
+        std::size_t open = 0; // idle plus in use
+        std::condition_variable available;
+    };
+
+    std::unique_ptr<httplib::Client> acquire(const std::string& origin_key, bool& reused) {
+        std::unique_lock<std::mutex> lock(mutex);
+        Origin& origin = origins[origin_key];
+        origin.available.wait(lock, [&] { return !origin.idle.empty() || origin.open < max_per_origin; });
+        if (!origin.idle.empty()) {
+            std::unique_ptr<httplib::Client> client = std::move(origin.idle.back());
+            origin.idle.pop_back();
+            reused = client->is_socket_open() != 0;
+            return client;
+        }
+        origin.open++;
+        lock.unlock();
+
+        auto client = std::make_unique<httplib::Client>(origin_key);
+        client->set_keep_alive(true);
+        client->set_follow_location(false);
+        client->set_connection_timeout(10);
+        client->set_read_timeout(10);
+        reused = false;
+        return client;
+    }
+
+    void release(const std::string& origin_key, std::unique_ptr<httplib::Client> client, bool keep) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Origin& origin = origins[origin_key];
+        if (keep) {
+            origin.idle.push_back(std::move(client));
+        }
+        else {
+            origin.open--;
+        }
+        origin.available.notify_one();
+    }
+
+    void record_hop(const std::string& origin_key, bool reused, double ttfb_ms) {
+        std::lock_guard<std::mutex> lock(mutex);
+        OriginStatistics& origin = stats[origin_key];
+        origin.requests++;
+        if (reused) {
+            origin.ttfb_reused_ms += ttfb_ms;
+        }
+        else {
+            origin.new_connections++;
+            origin.ttfb_new_ms += ttfb_ms;
+        }
+    }
+
+    void record_total(const std::string& origin_key, double total_ms) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats[origin_key].total_ms += total_ms;
+    }
+
+    std::size_t max_per_origin;
+    int max_redirects;
+    mutable std::mutex mutex;
+    std::map<std::string, Origin> origins;
+    std::map<std::string, OriginStatistics> stats;
+};
+
+#endif //FINALPROJECT_HTTP_CLIENT_POOL_H
@@ -0,0 +1,45 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_IMAGE_DECODE_H
+#define FINALPROJECT_IMAGE_DECODE_H
+
+#pragma once
+
+// Poster and welcome image decoding. Two builds of stb_image sit behind it: src/image_decode.cpp keeps
+// stb's SIMD JPEG kernels (SSE2 IDCT, chroma upsampling and YCbCr to RGB on x86, NEON on ARM) and
+// src/image_decode_scalar.cpp is built with STBI_NO_SIMD. DecodeImage takes the SIMD build when it was
+// compiled with its kernels and the CPU reports the instructions, checked once at runtime, and the
+// scalar build otherwise. Formats other than JPEG decode the same way in both. Both builds allocate
+// from the pixel arena, so every result is released with FreeDecodedImage whichever path made it.
+enum class DecodePath {
+    Scalar,
+    Simd,
+};
+
+// the SIMD build has its kernels and this CPU can run them
+bool SimdDecodeAvailable();
+
+// what DecodeImage uses unless told otherwise
+DecodePath ActiveDecodePath();
+
+const char* DecodePathName(DecodePath path);
+
+// stb_image semantics: desired_channels 0 keeps the file's, nullptr on failure
+unsigned char* DecodeImage(const unsigned char* data, int size, int* width, int* height, int* channels,
+    int desired_channels, DecodePath path = ActiveDecodePath());
+unsigned char* DecodeImageFile(const char* filename, int* width, int* height, int* channels,
+    int desired_channels, DecodePath path = ActiveDecodePath());
+
+// why the last decode on this thread through path failed
+const char* DecodeFailureReason(DecodePath path = ActiveDecodePath());
+
+void FreeDecodedImage(void* pixels);
+
+// the scalar build, called through DecodeImage
+unsigned char* DecodeImageScalar(const unsigned char* data, int size, int* width, int* height, int* channels, int desired_channels);
+unsigned char* DecodeImageFileScalar(const char* filename, int* width, int* height, int* channels, int desired_channels);
+const char* DecodeFailureReasonScalar();
+
+#endif //FINALPROJECT_IMAGE_DECODE_H
@@ -0,0 +1,128 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_IMAGE_WORK_QUEUE_H
+#define FINALPROJECT_IMAGE_WORK_QUEUE_H
+
+#pragma once
+
+#include <map>
+#include <algorithm>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+
+// Work queue of image urls indexed by url. A url is queued at most once: pushing it again only
+// raises its priority, and every entry remembers the search generation it was queued for so
+// work for results that are no longer on screen can be dropped in one go.
+// Higher priorities pop first, equal priorities pop in FIFO order.
+class ImageWorkQueue {
+private:
+    using Key = std::pair<int, unsigned long long>; // (-priority, sequence)
+
+    struct Entry {
+        Key key;
+        unsigned int generation;
+        std::chrono::steady_clock::time_point queued; // first push, reprioritizing keeps it
+    };
+
+    std::map<Key, std::string> order;
+    std::unordered_map<std::string, Entry> index;
+    unsigned long long sequence = 0;
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    bool stopped = false;
+
+    void erase(std::unordered_map<std::string, Entry>::iterator it) {
+        order.erase(it->second.key);
+        index.erase(it);
+    }
+
+    // caller holds mutex; moves a queued entry up to priority and keeps the newest generation
+    void raise(std::unordered_map<std::string, Entry>::iterator it, int priority, unsigned int generation) {
+        if (priority > -it->second.key.first) {
+            auto node = order.extract(it->second.key);
+            it->second.key = { -priority, sequence++ };
+            node.key() = it->second.key;
+            order.insert(std::move(node));
+        }
+        it->second.generation = std::max(it->second.generation, generation);
+    }
+
+public:
+    // returns false when the url was already queued, in which case it is only reprioritized
+    bool push(const std::string& url, int priority, unsigned int generation) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(url);
+        if (it != index.end()) {
+            raise(it, priority, generation);
+            return false;
+        }
+        Key key{ -priority, sequence++ };
+        order.emplace(key, url);
+        index.emplace(url, Entry{ key, generation, std::chrono::steady_clock::now() });
+        cond.notify_one();
+        return true;
+    }
+
+    // raises the priority of a queued url, returns false if it is not queued (anymore); never queues
+    // the url again, a worker may already have popped it
+    bool reprioritize(const std::string& url, int priority, unsigned int generation) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(url);
+        if (it == index.end()) {
+            return false;
+        }
+        raise(it, priority, generation);
+        return true;
+    }
+
+    // drops every entry queued for an older search, returns their urls
+    std::vector<std::string> cancel_older_than(unsigned int generation) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::string> cancelled;
+        for (auto it = index.begin(); it != index.end();) {
+            auto current = it++;
+            if (current->second.generation < generation) {
+                cancelled.push_back(current->first);
+                erase(current);
+            }
+        }
+        return cancelled;
+    }
+
+    // waits up to timeout for work, returns false on timeout or after stop(); priority receives the
+    // priority the url was queued with and queued the time it was first pushed
+    bool pop_for(std::string& url, std::chrono::milliseconds timeout, int* priority = nullptr,
+        std::chrono::steady_clock::time_point* queued = nullptr) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!cond.wait_for(lock, timeout, [this] { return !order.empty() || stopped; }) || stopped) {
+            return false;
+        }
+        auto first = order.begin();
+        if (priority != nullptr) *priority = -first->first.first;
+        url = std::move(first->second);
+        auto entry = index.find(url);
+        if (queued != nullptr) *queued = entry->second.queued;
+        index.erase(entry);
+        order.erase(first);
+        return true;
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+        cond.notify_all();
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return order.size();
+    }
+};
+
+#endif //FINALPROJECT_IMAGE_WORK_QUEUE_H
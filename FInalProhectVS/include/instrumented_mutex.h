@@ -0,0 +1,86 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_INSTRUMENTED_MUTEX_H
+#define FINALPROJECT_INSTRUMENTED_MUTEX_H
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+// std::mutex that counts how often it was taken, how often a thread had to wait for it and how long
+// it was held, so lock contention shows up in the statistics printed at shutdown.
+// Usable with std::lock_guard / std::unique_lock like any other mutex.
+class InstrumentedMutex {
+public:
+    struct Statistics {
+        unsigned long long acquisitions = 0;
+        unsigned long long contended = 0; // acquisitions that had to wait
+        double wait_ms = 0;
+        double hold_ms = 0;
+        double max_hold_ms = 0;
+
+        Statistics& operator+=(const Statistics& other) {
+            acquisitions += other.acquisitions;
+            contended += other.contended;
+            wait_ms += other.wait_ms;
+            hold_ms += other.hold_ms;
+            max_hold_ms = other.max_hold_ms > max_hold_ms ? other.max_hold_ms : max_hold_ms;
+            return *this;
+        }
+    };
+
+    void lock() {
+        if (!mutex.try_lock()) {
+            auto started = std::chrono::steady_clock::now();
+            mutex.lock();
+            locked_at = std::chrono::steady_clock::now();
+            contended.fetch_add(1, std::memory_order_relaxed);
+            wait_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(locked_at - started).count(), std::memory_order_relaxed);
+        }
+        else {
+            locked_at = std::chrono::steady_clock::now();
+        }
+        acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool try_lock() {
+        if (!mutex.try_lock()) return false;
+        locked_at = std::chrono::steady_clock::now();
+        acquisitions.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void unlock() {
+        long long held = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - locked_at).count();
+        hold_ns.fetch_add(held, std::memory_order_relaxed);
+        if (held > max_hold_ns.load(std::memory_order_relaxed)) {
+            max_hold_ns.store(held, std::memory_order_relaxed); // only the owner writes it
+        }
+        mutex.unlock();
+    }
+
+    Statistics statistics() const {
+        Statistics stats;
+        stats.acquisitions = acquisitions.load(std::memory_order_relaxed);
+        stats.contended = contended.load(std::memory_order_relaxed);
+        stats.wait_ms = wait_ns.load(std::memory_order_relaxed) / 1e6;
+        stats.hold_ms = hold_ns.load(std::memory_order_relaxed) / 1e6;
+        stats.max_hold_ms = max_hold_ns.load(std::memory_order_relaxed) / 1e6;
+        return stats;
+    }
+
+private:
+    std::mutex mutex;
+    std::chrono::steady_clock::time_point locked_at; // written and read by the owner only
+    std::atomic<unsigned long long> acquisitions{ 0 };
+    std::atomic<unsigned long long> contended{ 0 };
+    std::atomic<long long> wait_ns{ 0 };
+    std::atomic<long long> hold_ns{ 0 };
+    std::atomic<long long> max_hold_ns{ 0 };
+};
+
+#endif //FINALPROJECT_INSTRUMENTED_MUTEX_H
@@ -0,0 +1,229 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_KV_STORE_H
+#define FINALPROJECT_KV_STORE_H
+
+#pragma once
+
+#include <append_log.h>
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#define KV_STORE_MIN_COMPACT_RECORDS 1024 // smaller logs are never worth rewriting
+
+// Ordered string keys and values in a single file: every put and erase is one AppendLog record, and
+// an ordered in-memory index holds the live entries. Lookups are O(log n) and prefix scans are
+// O(log n + k), whatever else the file holds. Opening replays the log. When overwritten and erased
+// records outnumber the live ones, a compaction rewrites the live ones next to the file and renames
+// the result over it. Keys and values may hold any bytes: '\\', '\t' and '\n' are escaped in the
+// records, so a key never runs into its value and a record never spans two log lines.
+// Not thread safe, the owner serializes the calls. The one exception is write_compaction, which
+// only reads the copy begin_compaction made, so the owner can drop its lock for the slow part.
+class KvStore {
+public:
+    struct Statistics {
+        std::size_t keys = 0;
+        std::size_t log_records = 0; // live and dead, what a compaction would shrink to keys
+        unsigned long long lookups = 0;
+        unsigned long long scans = 0;
+        unsigned long long puts = 0;
+        unsigned long long erases = 0;
+        unsigned long long compactions = 0;
+        AppendLog::Statistics log;
+    };
+
+    // the live entries frozen by begin_compaction, written by write_compaction
+    struct Compaction {
+        std::map<std::string, std::string> entries;
+        std::filesystem::path temp_path;
+    };
+
+    // loads the store at path; false when there was no file yet
+    bool open(const std::filesystem::path& path) {
+        index.clear();
+        log.open(path);
+        std::error_code ec;
+        bool existed = std::filesystem::exists(path, ec);
+        log.replay([this](const std::string& record) { apply(record); });
+        return existed;
+    }
+
+    // false when key is not in the store
+    bool get(const std::string& key, std::string& value) {
+        lookups++;
+        auto it = index.find(key);
+        if (it == index.end()) return false;
+        value = it->second;
+        return true;
+    }
+
+    bool contains(const std::string& key) {
+        lookups++;
+        return index.find(key) != index.end();
+    }
+
+    // whether any key starts with prefix, O(log n) however many do
+    bool contains_prefix(const std::string& prefix) {
+        lookups++;
+        auto it = index.lower_bound(prefix);
+        return it != index.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    // fn(key, value) for every key starting with prefix, in key order
+    template <typename Fn>
+    void scan(const std::string& prefix, Fn fn) {
+        scans++;
+        for (auto it = index.lower_bound(prefix); it != index.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+            fn(it->first, it->second);
+        }
+    }
+
+    // false if the record could not be written; the index is only changed when it was
+    bool put(const std::string& key, const std::string& value) {
+        std::string record = "P" + escape(key) + "\t" + escape(value);
+        if (!log.append(record)) return false;
+        if (compacting) compaction_tail.push_back(std::move(record));
+        puts++;
+        index[key] = value;
+        return true;
+    }
+
+    bool erase(const std::string& key) {
+        if (index.find(key) == index.end()) return true;
+        std::string record = "D" + escape(key);
+        if (!log.append(record)) return false;
+        if (compacting) compaction_tail.push_back(std::move(record));
+        erases++;
+        index.erase(key);
+        return true;
+    }
+
+    // dead records outnumber the live ones and no compaction is running
+    bool needs_compaction() const {
+        return !compacting && log.records() >= KV_STORE_MIN_COMPACT_RECORDS && log.records() >= 2 * index.size();
+    }
+
+    // step 1 of a compaction: freezes a copy of the live entries; puts and erases made until
+    // finish_compaction are remembered and appended to the new file there
+    Compaction begin_compaction() {
+        compacting = true;
+        compaction_tail.clear();
+        std::filesystem::path temp_path = log.path();
+        temp_path += ".tmp";
+        return { index, temp_path };
+    }
+
+    // step 2: writes the frozen entries to the temporary file; touches nothing else of the store
+    static bool write_compaction(const Compaction& compaction) {
+        AppendLog compacted;
+        compacted.open(compaction.temp_path);
+        compacted.clear();
+        for (const auto& [key, value] : compaction.entries) {
+            if (!compacted.append("P" + escape(key) + "\t" + escape(value))) return false;
+        }
+        return true;
+    }
+
+    // step 3: appends what changed since step 1 and renames the result over the file; when written is
+    // false, or anything here fails, the old file stays in place
+    bool finish_compaction(const Compaction& compaction, bool written) {
+        compacting = false;
+        std::vector<std::string> tail;
+        tail.swap(compaction_tail);
+        std::error_code ec;
+        if (written) {
+            AppendLog compacted;
+            compacted.open(compaction.temp_path);
+            for (const auto& record : tail) {
+                written = written && compacted.append(record);
+            }
+        }
+        if (!written) {
+            std::filesystem::remove(compaction.temp_path, ec);
+            return false;
+        }
+        std::filesystem::path path = log.path();
+        log.close();
+        std::filesystem::rename(compaction.temp_path, path, ec);
+        if (ec) return false;
+        log.open(path);
+        log.replay([](const std::string&) {}); // counts the records again
+        compactions++;
+        return true;
+    }
+
+    // rewrites the file with only the live entries in one go; false leaves the old file in place
+    bool compact() {
+        Compaction compaction = begin_compaction();
+        return finish_compaction(compaction, write_compaction(compaction));
+    }
+
+    // compacts once dead records outnumber the live ones
+    bool compact_if_needed() {
+        if (!needs_compaction()) return false;
+        return compact();
+    }
+
+    Statistics statistics() const {
+        return { index.size(), log.records(), lookups, scans, puts, erases, compactions, log.statistics() };
+    }
+
+private:
+    void apply(const std::string& record) { // replay
+        if (record.empty()) return;
+        if (record[0] == 'P') {
+            std::size_t tab = record.find('\t');
+            if (tab == std::string::npos) return;
+            index[unescape(record.substr(1, tab - 1))] = unescape(record.substr(tab + 1));
+        }
+        else if (record[0] == 'D') {
+            index.erase(unescape(record.substr(1)));
+        }
+    }
+
+    static std::string escape(const std::string& text) {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (char c : text) {
+            switch (c) {
+            case '\\': escaped += "\\\\"; break;
+            case '\t': escaped += "\\t"; break;
+            case '\n': escaped += "\\n"; break;
+            default: escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    static std::string unescape(const std::string& text) {
+        std::string plain;
+        plain.reserve(text.size());
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            if (text[i] != '\\' || i + 1 == text.size()) {
+                plain += text[i];
+                continue;
+            }
+            char c = text[++i];
+            plain += c == 't' ? '\t' : c == 'n' ? '\n' : c;
+        }
+        return plain;
+    }
+
+    AppendLog log;
+    std::map<std::string, std::string> index; // the live entries, ordered for the scans
+    unsigned long long lookups = 0;
+    unsigned long long scans = 0;
+    unsigned long long puts = 0;
+    unsigned long long erases = 0;
+    unsigned long long compactions = 0;
+    bool compacting = false; // between begin_compaction and finish_compaction
+    std::vector<std::string> compaction_tail; // records written meanwhile, in order
+};
+
+#endif //FINALPROJECT_KV_STORE_H
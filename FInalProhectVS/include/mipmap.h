@@ -0,0 +1,97 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_MIPMAP_H
+#define FINALPROJECT_MIPMAP_H
+
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIPMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+// Mip chains for RGBA images. Level n is floor(width / 2^n) x floor(height / 2^n) (at least 1x1),
+// the same sizes OpenGL expects, and levels 1.. are stored back to back in one buffer.
+
+inline int MipLevelCount(int width, int height) {
+    int levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        ++levels;
+    }
+    return levels;
+}
+
+// bytes needed for levels 1.. of an RGBA image
+inline std::size_t MipChainSize(int width, int height) {
+    std::size_t size = 0;
+    while (width > 1 || height > 1) {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        size += static_cast<std::size_t>(width) * height * 4;
+    }
+    return size;
+}
+
+// 2x2 box filter, an odd last row / column is dropped
+inline void DownsampleRgba(const unsigned char* src, int src_width, int src_height, unsigned char* dst) {
+    int dst_width = std::max(1, src_width / 2);
+    int dst_height = std::max(1, src_height / 2);
+    for (int y = 0; y < dst_height; ++y) {
+        const unsigned char* row0 = src + static_cast<std::size_t>(std::min(2 * y, src_height - 1)) * src_width * 4;
+        const unsigned char* row1 = src + static_cast<std::size_t>(std::min(2 * y + 1, src_height - 1)) * src_width * 4;
+        unsigned char* out = dst + static_cast<std::size_t>(y) * dst_width * 4;
+        int x = 0;
+        if (src_width > 1) {
+#ifdef MIPMAP_SSE2
+            // four output pixels per step: widen to 16 bit, add the rows, then the even and odd pixels,
+            // and round exactly like the scalar loop so the levels do not depend on which path ran
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i two = _mm_set1_epi16(2);
+            for (; x + 4 <= dst_width; x += 4) {
+                __m128i sums[2];
+                for (int half = 0; half < 2; ++half) {
+                    __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8 + half * 16));
+                    __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8 + half * 16));
+                    __m128i pixels01 = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+                    __m128i pixels23 = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+                    __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(pixels01, pixels23), _mm_unpackhi_epi64(pixels01, pixels23));
+                    sums[half] = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), _mm_packus_epi16(sums[0], sums[1]));
+            }
+#endif
+            for (; x < dst_width; ++x) {
+                for (int c = 0; c < 4; ++c) {
+                    int sum = row0[x * 8 + c] + row0[x * 8 + 4 + c] + row1[x * 8 + c] + row1[x * 8 + 4 + c];
+                    out[x * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
+        }
+        else {
+            for (int c = 0; c < 4; ++c) {
+                out[c] = static_cast<unsigned char>((row0[c] + row1[c] + 1) / 2);
+            }
+        }
+    }
+}
+
+// fills chain (MipChainSize bytes) with levels 1.. of base
+inline void BuildMipChain(const unsigned char* base, int width, int height, unsigned char* chain) {
+    const unsigned char* src = base;
+    while (width > 1 || height > 1) {
+        DownsampleRgba(src, width, height, chain);
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        src = chain;
+        chain += static_cast<std::size_t>(width) * height * 4;
+    }
+}
+
+#endif //FINALPROJECT_MIPMAP_H
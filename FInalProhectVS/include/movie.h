@@ -0,0 +1,136 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_MOVIE_H
+#define FINALPROJECT_MOVIE_H
+
+#pragma once
+
+#include <string_pool.h>
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#define MOVIE_MAX_GENRES 4
+#define MOVIE_MAX_CAST 4
+
+// One search result or watch list entry. Only what the tables sort and filter on is kept as numbers
+// and interned ids; the OMDb text is parsed once, by the functions below, when a record is filled.
+struct Movie {
+    std::string id; // imdbID, fits the small string buffer
+    std::string title; // set through SetTitle so the sort keys follow it
+    std::string sort_title; // TitleSortKey(title)
+    std::string poster_url;
+    std::uint64_t title_key = 0; // first 8 bytes of sort_title, big endian, 0 padded
+    std::uint32_t votes = 0;
+    StringId director = 0; // see string_pool.h
+    StringId genres[MOVIE_MAX_GENRES] = {};
+    StringId cast[MOVIE_MAX_CAST] = {};
+    std::int16_t year_from = 0; // 0 when unknown
+    std::int16_t year_to = 0; // == year_from for a single year, 0 for a series that is still running
+    std::uint16_t runtime_minutes = 0; // 0 when unknown
+    std::uint8_t rating_tenths = 0; // IMDb rating * 10, 0 when unknown
+    std::uint8_t genre_count = 0;
+    std::uint8_t cast_count = 0;
+    bool details_loaded = false; // the OMDb details were fetched for this movie
+};
+
+inline void ParseYearRange(const std::string& text, Movie& movie) { // "1999", "2010–2014" or "2010–"
+    int years[2] = { 0, 0 };
+    int found = 0;
+    for (std::size_t i = 0; i < text.size() && found < 2;) {
+        if (std::isdigit((unsigned char)text[i])) {
+            int value = 0;
+            while (i < text.size() && std::isdigit((unsigned char)text[i])) {
+                value = value * 10 + (text[i++] - '0');
+            }
+            years[found++] = value;
+        }
+        else {
+            ++i;
+        }
+    }
+    movie.year_from = (std::int16_t)years[0];
+    bool open_range = found == 1 && text.find_first_not_of("0123456789") != std::string::npos;
+    movie.year_to = (std::int16_t)(found == 2 ? years[1] : (open_range ? 0 : years[0]));
+}
+inline std::string YearText(const Movie& movie) {
+    if (movie.year_from == 0) return "N/A";
+    if (movie.year_to == movie.year_from) return std::to_string(movie.year_from);
+    return std::to_string(movie.year_from) + "\xE2\x80\x93" + (movie.year_to != 0 ? std::to_string(movie.year_to) : ""); // en dash, like OMDb
+}
+inline std::string TitleSortKey(std::string_view title) { // case folded, a leading "The", "A" or "An" does not count
+    std::string key(title);
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    for (std::string_view article : { "the ", "a ", "an " }) {
+        if (key.size() > article.size() && key.compare(0, article.size(), article) == 0) {
+            key.erase(0, article.size());
+            break;
+        }
+    }
+    return key;
+}
+inline void SetTitle(Movie& movie, std::string title) {
+    movie.sort_title = TitleSortKey(title);
+    movie.title_key = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+        movie.title_key = (movie.title_key << 8) | (i < movie.sort_title.size() ? (unsigned char)movie.sort_title[i] : 0);
+    }
+    movie.title = std::move(title);
+}
+inline std::uint16_t ParseRuntime(const std::string& text) { // "142 min"
+    int minutes = std::atoi(text.c_str());
+    return (std::uint16_t)std::clamp(minutes, 0, 65535);
+}
+inline std::uint8_t ParseRating(const std::string& text) { // "8.7"
+    if (text.empty() || !std::isdigit((unsigned char)text[0])) return 0;
+    int tenths = (text[0] - '0') * 10;
+    std::size_t dot = text.find('.');
+    if (dot == 1 && dot + 1 < text.size() && std::isdigit((unsigned char)text[dot + 1])) {
+        tenths += text[dot + 1] - '0';
+    }
+    else if (text.size() > 1 && text[1] == '0') {
+        tenths = 100; // "10"
+    }
+    return (std::uint8_t)tenths;
+}
+inline std::uint32_t ParseVotes(const std::string& text) { // "2,345,678"
+    std::uint64_t votes = 0;
+    for (char c : text) {
+        if (std::isdigit((unsigned char)c)) votes = std::min<std::uint64_t>(votes * 10 + (c - '0'), UINT32_MAX);
+    }
+    return (std::uint32_t)votes;
+}
+inline std::string VotesText(std::uint32_t votes) {
+    std::string digits = std::to_string(votes);
+    std::string text;
+    for (std::size_t i = 0; i < digits.size(); ++i) {
+        if (i > 0 && (digits.size() - i) % 3 == 0) text += ',';
+        text += digits[i];
+    }
+    return text;
+}
+// splits a comma separated OMDb list into interned ids, returns how many fit
+inline std::uint8_t InternList(const std::string& text, StringId* ids, int max) {
+    int count = 0;
+    std::size_t start = 0;
+    while (start <= text.size() && count < max) {
+        std::size_t end = text.find(',', start);
+        if (end == std::string::npos) end = text.size();
+        std::size_t first = text.find_first_not_of(' ', start);
+        std::size_t last = text.find_last_not_of(' ', end == 0 ? 0 : end - 1);
+        if (first != std::string::npos && first < end && last != std::string::npos && last >= first) {
+            ids[count++] = Intern(std::string_view(text).substr(first, last - first + 1));
+        }
+        start = end + 1;
+    }
+    return (std::uint8_t)count;
+}
+
+#endif //FINALPROJECT_MOVIE_H
@@ -0,0 +1,79 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_MOVIE_SORT_H
+#define FINALPROJECT_MOVIE_SORT_H
+
+#pragma once
+
+#include <movie.h>
+#include <radix_sort.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Sort keys of the movie tables. A permutation is built one key at a time, least significant key
+// first; every SortRowsBy pass is stable, so rows that tie keep the order of the previous pass.
+enum class SortColumn { Title = 0, Year = 1, Rating = 2, Votes = 3, Runtime = 4 }; // also the table column user ids
+struct SortKey {
+    SortColumn column = SortColumn::Title;
+    bool ascending = true;
+};
+using SortSpec = std::vector<SortKey>; // most significant key first, like ImGuiTableSortSpecs
+
+inline std::uint32_t YearSortKey(const Movie& movie) { // year_from, then year_to
+    return (std::uint32_t)(std::uint16_t)movie.year_from << 16 | (std::uint16_t)movie.year_to;
+}
+inline std::uint32_t NumericSortKey(const Movie& movie, SortColumn column) {
+    switch (column) {
+    case SortColumn::Year: return YearSortKey(movie);
+    case SortColumn::Rating: return movie.rating_tenths;
+    case SortColumn::Votes: return movie.votes;
+    case SortColumn::Runtime: return movie.runtime_minutes;
+    default: return 0;
+    }
+}
+inline int CompareMovies(const Movie& a, const Movie& b, SortColumn column) { // <0, 0 or >0, ascending
+    if (column == SortColumn::Title) {
+        return a.sort_title.compare(b.sort_title);
+    }
+    std::uint32_t ka = NumericSortKey(a, column), kb = NumericSortKey(b, column);
+    return ka < kb ? -1 : (ka > kb ? 1 : 0);
+}
+// stable pass over order by one key: a radix pass on the numeric key or the packed title prefix
+// (inverted when descending), then the rest of the folded title for rows that tie on the prefix
+inline void SortRowsBy(const std::vector<std::shared_ptr<const Movie>>& records, SortKey key, std::vector<std::uint32_t>& order) {
+    if (key.column != SortColumn::Title) {
+        std::vector<std::uint32_t> keys(records.size());
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            std::uint32_t value = NumericSortKey(*records[i], key.column);
+            keys[i] = key.ascending ? value : ~value;
+        }
+        RadixSortIndices(keys, order);
+        return;
+    }
+    std::vector<std::uint64_t> keys(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        keys[i] = key.ascending ? records[i]->title_key : ~records[i]->title_key;
+    }
+    RadixSortIndices(keys, order);
+    // rows sharing a full 8-byte prefix are ordered by the rest of the folded title
+    for (std::size_t first = 0; first < order.size();) {
+        std::size_t last = first + 1;
+        while (last < order.size() && keys[order[last]] == keys[order[first]]) ++last;
+        if (last - first > 1 && (records[order[first]]->title_key & 0xFF) != 0) {
+            std::stable_sort(order.begin() + first, order.begin() + last,
+                [&](std::uint32_t a, std::uint32_t b) {
+                    int c = records[a]->sort_title.compare(8, std::string::npos, records[b]->sort_title, 8, std::string::npos);
+                    return key.ascending ? c < 0 : c > 0;
+                });
+        }
+        first = last;
+    }
+}
+
+#endif //FINALPROJECT_MOVIE_SORT_H
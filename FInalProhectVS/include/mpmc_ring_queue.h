@@ -0,0 +1,200 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_MPMC_RING_QUEUE_H
+#define FINALPROJECT_MPMC_RING_QUEUE_H
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+// Bounded lock-free multi-producer / multi-consumer ring (Vyukov's sequence-per-slot design) with
+// the same interface as ThreadSafeQueue plus try_push / try_pop. Capacity is rounded up to a power
+// of two. push blocks while the ring is full and pop while it is empty; both spin briefly, then
+// sleep on std::atomic::wait, and a wake-up is only issued when somebody is actually sleeping.
+template <typename T>
+class MpmcRingQueue {
+private:
+    static constexpr std::size_t cache_line = 64;
+    static constexpr int spin_limit = 16; // tries before going to sleep, hand-offs are usually quick
+
+    struct alignas(cache_line) Slot {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    struct alignas(cache_line) Signal {
+        std::atomic<std::uint32_t> version{ 0 };
+        std::atomic<int> waiters{ 0 };
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+    alignas(cache_line) std::atomic<std::size_t> enqueue_pos{ 0 };
+    alignas(cache_line) std::atomic<std::size_t> dequeue_pos{ 0 };
+    Signal pushed; // bumped after every push, consumers sleep on it
+    Signal popped; // bumped after every pop, producers sleep on it
+    alignas(cache_line) std::atomic<bool> finished{ false };
+    std::atomic<unsigned long long> full_waits{ 0 };
+
+    static std::size_t round_up(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+
+    // called after publishing a slot; the fence pairs with the one in wait_for so either the
+    // sleeper sees the new slot or we see the sleeper
+    static void signal(Signal& signal) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (signal.waiters.load(std::memory_order_relaxed) > 0) {
+            signal.version.fetch_add(1);
+            signal.version.notify_one();
+        }
+    }
+
+    // runs attempt until it succeeds, sleeping on signal in between; gives up once the queue is finished
+    template <typename Attempt>
+    bool wait_for(Signal& signal, Attempt attempt) {
+        while (true) {
+            for (int spin = 0; spin < spin_limit; ++spin) {
+                if (attempt()) return true;
+                std::this_thread::yield();
+            }
+            if (finished.load()) return attempt();
+            signal.waiters.fetch_add(1);
+            std::uint32_t seen = signal.version.load();
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool done = attempt();
+            if (!done && !finished.load()) {
+                signal.version.wait(seen);
+            }
+            signal.waiters.fetch_sub(1);
+            if (done) return true;
+        }
+    }
+
+public:
+    explicit MpmcRingQueue(std::size_t capacity) : slots(new Slot[round_up(capacity)]), mask(round_up(capacity) - 1) {
+        for (std::size_t i = 0; i <= mask; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRingQueue(const MpmcRingQueue&) = delete;
+    MpmcRingQueue& operator=(const MpmcRingQueue&) = delete;
+
+    ~MpmcRingQueue() {
+        T value;
+        while (try_pop(value)) {}
+    }
+
+    bool try_push(T& value) {
+        std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots[pos & mask];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    new (slot.storage) T(std::move(value));
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    signal(pushed);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false; // full
+            }
+            else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(T& value) {
+        std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots[pos & mask];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    T* stored = slot.value();
+                    value = std::move(*stored);
+                    stored->~T();
+                    slot.sequence.store(pos + mask + 1, std::memory_order_release);
+                    signal(popped);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false; // empty
+            }
+            else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // blocks while the ring is full, returns false if the queue was finished while still full
+    bool push(T value) {
+        if (try_push(value)) return true;
+        full_waits++;
+        return wait_for(popped, [&] { return try_push(value); });
+    }
+
+    // blocks while the ring is empty, returns false once it is finished and drained
+    bool pop(T& value) {
+        return wait_for(pushed, [&] { return try_pop(value); });
+    }
+
+    bool is_finished() const {
+        return finished.load();
+    }
+
+    void setFinished() {
+        finished.store(true);
+        pushed.version.fetch_add(1);
+        pushed.version.notify_all();
+        popped.version.fetch_add(1);
+        popped.version.notify_all();
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // approximate while other threads are pushing or popping
+    std::size_t size() const {
+        std::size_t tail = dequeue_pos.load();
+        std::size_t head = enqueue_pos.load();
+        return head > tail ? head - tail : 0;
+    }
+
+    std::size_t capacity() const {
+        return mask + 1;
+    }
+
+    // pushes that found the ring full and had to wait for a consumer
+    unsigned long long backpressure_waits() const {
+        return full_waits.load();
+    }
+
+    void clear() {
+        T value;
+        while (try_pop(value)) {}
+        finished.store(false);
+    }
+};
+
+#endif //FINALPROJECT_MPMC_RING_QUEUE_H
@@ -0,0 +1,179 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_PIXEL_ARENA_H
+#define FINALPROJECT_PIXEL_ARENA_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include <atomic>
+
+// Recycling allocator for the image subsystem. Blocks are rounded up to a power of two and go back
+// to a free list for their size class when released, so once the first few posters went through,
+// decoding more of them is served entirely from memory that was already allocated.
+class PixelArena {
+public:
+    struct Statistics {
+        unsigned long long allocations = 0;
+        unsigned long long heap_allocations = 0; // allocations the free lists could not serve
+        std::size_t cached_bytes = 0;
+    };
+
+    static PixelArena& instance() {
+        static PixelArena arena;
+        return arena;
+    }
+
+    ~PixelArena() {
+        for (auto& list : free_lists) {
+            for (void* block : list) {
+                std::free(block);
+            }
+        }
+    }
+
+    void* allocate(std::size_t size) {
+        allocations++;
+        int size_class = class_for(size);
+        if (size_class < 0) {
+            heap_allocations++;
+            return tag(std::malloc(size + header_size), oversized);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto& list = free_lists[size_class];
+            if (!list.empty()) {
+                void* block = list.back();
+                list.pop_back();
+                cached_bytes -= class_size(size_class);
+                return tag(block, size_class);
+            }
+        }
+        heap_allocations++;
+        return tag(std::malloc(class_size(size_class) + header_size), size_class);
+    }
+
+    void* reallocate(void* ptr, std::size_t old_size, std::size_t new_size) {
+        if (ptr == nullptr) {
+            return allocate(new_size);
+        }
+        int size_class = class_of(ptr);
+        if (size_class != oversized && new_size <= class_size(size_class)) {
+            return ptr;
+        }
+        void* grown = allocate(new_size);
+        if (grown != nullptr) {
+            std::memcpy(grown, ptr, old_size < new_size ? old_size : new_size);
+        }
+        release(ptr);
+        return grown;
+    }
+
+    void release(void* ptr) {
+        if (ptr == nullptr) return;
+        int size_class = class_of(ptr);
+        void* block = static_cast<unsigned char*>(ptr) - header_size;
+        if (size_class != oversized) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (cached_bytes + class_size(size_class) <= max_cached_bytes) {
+                free_lists[size_class].push_back(block);
+                cached_bytes += class_size(size_class);
+                return;
+            }
+        }
+        std::free(block);
+    }
+
+    Statistics statistics() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return { allocations.load(), heap_allocations.load(), cached_bytes };
+    }
+
+private:
+    static constexpr std::size_t header_size = 16; // keeps the returned memory 16 byte aligned for the SIMD decoders
+    static constexpr int min_class_bits = 8;
+    static constexpr int class_count = 24; // 256 bytes up to 2 GB
+    static constexpr int oversized = -1;
+    static constexpr std::size_t max_cached_bytes = 256u * 1024u * 1024u;
+
+    static std::size_t class_size(int size_class) {
+        return std::size_t(1) << (size_class + min_class_bits);
+    }
+
+    static int class_for(std::size_t size) {
+        for (int size_class = 0; size_class < class_count; ++size_class) {
+            if (size <= class_size(size_class)) {
+                return size_class;
+            }
+        }
+        return oversized;
+    }
+
+    static void* tag(void* block, int size_class) {
+        if (block == nullptr) return nullptr;
+        std::memcpy(block, &size_class, sizeof(size_class));
+        return static_cast<unsigned char*>(block) + header_size;
+    }
+
+    static int class_of(void* ptr) {
+        int size_class;
+        std::memcpy(&size_class, static_cast<unsigned char*>(ptr) - header_size, sizeof(size_class));
+        return size_class;
+    }
+
+    mutable std::mutex mutex;
+    std::vector<void*> free_lists[class_count];
+    std::size_t cached_bytes = 0;
+    std::atomic<unsigned long long> allocations{ 0 };
+    std::atomic<unsigned long long> heap_allocations{ 0 };
+};
+
+// Pool of reusable byte buffers for downloaded image bodies and encoded texture blocks. A released
+// buffer keeps its capacity, so filling it again does not reallocate unless the data is bigger than
+// any before.
+class ByteBufferPool {
+public:
+    std::vector<unsigned char> acquire() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (buffers.empty()) {
+            return {};
+        }
+        std::vector<unsigned char> buffer = std::move(buffers.back());
+        buffers.pop_back();
+        return buffer;
+    }
+
+    void release(std::vector<unsigned char>&& buffer) {
+        if (buffer.capacity() == 0) return;
+        buffer.clear();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (buffers.size() < max_buffers) {
+            buffers.push_back(std::move(buffer));
+        }
+    }
+
+private:
+    static constexpr std::size_t max_buffers = 32;
+    std::mutex mutex;
+    std::vector<std::vector<unsigned char>> buffers;
+};
+
+inline void* PixelArenaMalloc(std::size_t size) {
+    return PixelArena::instance().allocate(size);
+}
+
+inline void* PixelArenaRealloc(void* ptr, std::size_t old_size, std::size_t new_size) {
+    return PixelArena::instance().reallocate(ptr, old_size, new_size);
+}
+
+inline void PixelArenaFree(void* ptr) {
+    PixelArena::instance().release(ptr);
+}
+
+#endif //FINALPROJECT_PIXEL_ARENA_H
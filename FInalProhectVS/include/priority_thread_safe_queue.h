@@ -0,0 +1,208 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_PRIORITY_THREAD_SAFE_QUEUE_H
+#define FINALPROJECT_PRIORITY_THREAD_SAFE_QUEUE_H
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+// ThreadSafeQueue with one FIFO per priority level (0 is lowest). Pops take the highest non-empty
+// level, so urgent work jumps ahead of bulk work. Once an entry of a lower level has waited longer
+// than aging it is starving, and every (aged_every + 1)th pop goes to the longest starving entry:
+// bulk work keeps a guaranteed share under load while urgent work only gives up that one slot.
+template <typename T>
+class PriorityThreadSafeQueue {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        T value;
+        Clock::time_point queued;
+    };
+
+    std::vector<std::deque<Entry>> levels;
+    std::vector<std::size_t> max_depths;
+    Clock::duration aging;
+    std::size_t capacity; // 0 means unbounded
+    std::size_t count = 0;
+    int aged_every;
+    int bypassed = 0; // pops in a row that skipped a starving entry
+    unsigned long long aged = 0; // pops that went to a lower level because of aging
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    std::condition_variable not_full;
+    bool finished = false;
+
+    int clamp(int priority) const {
+        return priority < 0 ? 0 : (priority >= (int)levels.size() ? (int)levels.size() - 1 : priority);
+    }
+
+    void enqueue(T&& value, int level, Clock::time_point now) {
+        levels[level].push_back(Entry{ std::move(value), now });
+        ++count;
+        if (levels[level].size() > max_depths[level]) {
+            max_depths[level] = levels[level].size();
+        }
+    }
+
+    // caller holds the lock and made sure the queue is not empty
+    T dequeue(Clock::time_point now) {
+        int highest = (int)levels.size() - 1;
+        while (levels[highest].empty()) --highest;
+
+        // the lower level whose oldest entry waited longest past the aging limit, if any
+        int starving = -1;
+        Clock::duration longest{};
+        for (int level = 0; level < highest; ++level) {
+            if (levels[level].empty()) continue;
+            Clock::duration waited = now - levels[level].front().queued;
+            if (waited >= aging && (starving < 0 || waited > longest)) {
+                starving = level;
+                longest = waited;
+            }
+        }
+
+        int chosen = highest;
+        if (starving < 0) {
+            bypassed = 0;
+        }
+        else if (++bypassed > aged_every) {
+            chosen = starving;
+            bypassed = 0;
+            ++aged;
+        }
+        T value = std::move(levels[chosen].front().value);
+        levels[chosen].pop_front();
+        --count;
+        return value;
+    }
+
+    bool full() const {
+        return capacity != 0 && count >= capacity;
+    }
+
+public:
+    PriorityThreadSafeQueue(int level_count, std::chrono::milliseconds aging, std::size_t capacity = 0, int aged_every = 4)
+        : levels(level_count < 1 ? 1 : level_count), max_depths(levels.size(), 0),
+          aging(aging), capacity(capacity), aged_every(aged_every < 0 ? 0 : aged_every) {}
+
+    bool is_finished() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return finished;
+    }
+
+    // blocks while a bounded queue is full, returns false if the queue was finished while waiting
+    bool push(T value, int priority) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this] { return !full() || finished; });
+        if (full()) {
+            return false;
+        }
+        enqueue(std::move(value), clamp(priority), Clock::now());
+        cond.notify_one();
+        return true;
+    }
+
+    // one lock for the whole batch, ignores the capacity so a batch is never split
+    void push_batch(std::vector<T>& values, int priority) {
+        if (values.empty()) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto now = Clock::now();
+        for (auto& value : values) {
+            enqueue(std::move(value), clamp(priority), now);
+        }
+        values.clear();
+        cond.notify_all();
+    }
+
+    bool pop(T& value) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this] { return count > 0 || finished; });
+        if (count == 0) {
+            return false;
+        }
+        value = dequeue(Clock::now());
+        not_full.notify_one();
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count == 0) {
+            return false;
+        }
+        value = dequeue(Clock::now());
+        not_full.notify_one();
+        return true;
+    }
+
+    // moves up to max values to the back of out in priority order without waiting, returns how many
+    std::size_t drain_into(std::vector<T>& out, std::size_t max) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto now = Clock::now();
+        std::size_t moved = 0;
+        while (count > 0 && moved < max) {
+            out.push_back(dequeue(now));
+            ++moved;
+        }
+        if (moved > 0) {
+            not_full.notify_all();
+        }
+        return moved;
+    }
+
+    void setFinished() {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+        cond.notify_all();
+        not_full.notify_all();
+    }
+
+    bool empty() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return count == 0;
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return count;
+    }
+
+    std::size_t depth(int priority) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return levels[clamp(priority)].size();
+    }
+
+    std::size_t max_depth(int priority) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return max_depths[clamp(priority)];
+    }
+
+    int level_count() const {
+        return (int)levels.size();
+    }
+
+    unsigned long long aged_pops() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return aged;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& level : levels) {
+            level.clear();
+        }
+        count = 0;
+        finished = false;
+        not_full.notify_all();
+    }
+};
+
+#endif //FINALPROJECT_PRIORITY_THREAD_SAFE_QUEUE_H
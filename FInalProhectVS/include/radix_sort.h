@@ -0,0 +1,67 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_RADIX_SORT_H
+#define FINALPROJECT_RADIX_SORT_H
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#define RADIX_SORT_MIN_ROWS 64 // below this a comparison sort is cheaper than the histograms
+
+// Stable sort of the row indices in order by keys[row], ascending. LSD radix sort, one byte per
+// pass; a histogram of every byte is taken up front so passes where all keys share the byte are
+// skipped, e.g. the high bytes of years or the tail of short title prefixes.
+template <typename Key>
+void RadixSortIndices(const std::vector<Key>& keys, std::vector<std::uint32_t>& order) {
+    static_assert(std::is_unsigned_v<Key>, "radix keys must be unsigned");
+    const std::size_t n = order.size();
+    if (n < RADIX_SORT_MIN_ROWS) {
+        std::stable_sort(order.begin(), order.end(),
+            [&](std::uint32_t a, std::uint32_t b) { return keys[a] < keys[b]; });
+        return;
+    }
+
+    // sorts (key, row) pairs so every pass streams through memory instead of gathering keys[row]
+    struct Item {
+        Key key;
+        std::uint32_t row;
+    };
+    constexpr int passes = sizeof(Key);
+    std::vector<std::uint32_t> counts(passes * 256, 0);
+    std::vector<Item> items(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        Key key = keys[order[i]];
+        items[i] = Item{ key, order[i] };
+        for (int pass = 0; pass < passes; ++pass) {
+            counts[pass * 256 + ((key >> (pass * 8)) & 0xFF)]++;
+        }
+    }
+
+    std::vector<Item> scratch(n);
+    for (int pass = 0; pass < passes; ++pass) {
+        std::uint32_t* count = &counts[pass * 256];
+        if (std::find(count, count + 256, (std::uint32_t)n) != count + 256) continue; // one bucket holds everything
+
+        std::uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            std::uint32_t size = count[bucket];
+            count[bucket] = offset;
+            offset += size;
+        }
+        for (const Item& item : items) {
+            scratch[count[(item.key >> (pass * 8)) & 0xFF]++] = item;
+        }
+        items.swap(scratch);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        order[i] = items[i].row;
+    }
+}
+
+#endif //FINALPROJECT_RADIX_SORT_H
@@ -0,0 +1,49 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_RATE_LIMITER_H
+#define FINALPROJECT_RATE_LIMITER_H
+
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+// Token bucket shared by every thread that talks to the same API: up to burst requests at once,
+// refilled at rate_per_second.
+class RateLimiter {
+private:
+    std::mutex mutex;
+    double rate_per_second;
+    double burst;
+    double tokens;
+    std::chrono::steady_clock::time_point last_refill = std::chrono::steady_clock::now();
+
+public:
+    RateLimiter(double rate_per_second, double burst)
+        : rate_per_second(rate_per_second), burst(burst), tokens(burst) {}
+
+    // blocks until a request may be sent
+    void acquire() {
+        while (true) {
+            std::chrono::duration<double> wait;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto now = std::chrono::steady_clock::now();
+                tokens = std::min(burst, tokens + std::chrono::duration<double>(now - last_refill).count() * rate_per_second);
+                last_refill = now;
+                if (tokens >= 1.0) {
+                    tokens -= 1.0;
+                    return;
+                }
+                wait = std::chrono::duration<double>((1.0 - tokens) / rate_per_second);
+            }
+            std::this_thread::sleep_for(wait);
+        }
+    }
+};
+
+#endif //FINALPROJECT_RATE_LIMITER_H
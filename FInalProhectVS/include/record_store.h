@@ -0,0 +1,196 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_RECORD_STORE_H
+#define FINALPROJECT_RECORD_STORE_H
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#define RECORD_STORE_CHANGE_LOG 1024 // replacements remembered for changed_since
+
+// One shared, immutable record per key. Lists, queues and selections hold 8-byte handles instead of
+// copies; replacing a record through the store is seen by every handle on its next get(). A reader
+// keeps the version it loaded alive for as long as it holds the shared_ptr, like Snapshot.
+// Handles are counted: when the last handle of a key goes away its slot and record are freed and a
+// later insert of the key starts over. Lookups hand out handles under the store's lock and the last
+// release takes it exclusively, so a slot that is still in the index always has a handle. Handles
+// must not outlive the store.
+template <typename Record>
+class RecordStore {
+private:
+    struct Slot {
+        Slot(RecordStore* store, std::string key, std::shared_ptr<const Record> record)
+            : store(store), key(std::move(key)), record(std::move(record)) {}
+        RecordStore* const store;
+        const std::string key;
+        std::atomic<std::shared_ptr<const Record>> record;
+        std::atomic<std::size_t> handles{ 0 };
+    };
+
+public:
+    class Handle {
+    public:
+        Handle() = default;
+        Handle(const Handle& other) : slot(other.slot) {
+            if (slot) slot->handles.fetch_add(1, std::memory_order_relaxed);
+        }
+        Handle(Handle&& other) noexcept : slot(other.slot) {
+            other.slot = nullptr;
+        }
+        Handle& operator=(Handle other) noexcept {
+            std::swap(slot, other.slot);
+            return *this;
+        }
+        ~Handle() {
+            if (slot) slot->store->release(slot);
+        }
+
+        std::shared_ptr<const Record> get() const {
+            return slot ? slot->record.load(std::memory_order_acquire) : nullptr;
+        }
+
+        const std::string& key() const {
+            static const std::string none;
+            return slot ? slot->key : none;
+        }
+
+        explicit operator bool() const { return slot != nullptr; }
+        bool operator==(const Handle& other) const { return slot == other.slot; }
+        bool operator!=(const Handle& other) const { return slot != other.slot; }
+
+    private:
+        friend class RecordStore;
+        explicit Handle(Slot* slot) : slot(slot) { // store's lock held, or another handle of slot is alive
+            slot->handles.fetch_add(1, std::memory_order_relaxed);
+        }
+        Slot* slot = nullptr;
+    };
+
+    struct Statistics {
+        std::size_t records = 0; // alive now
+        unsigned long long inserts = 0; // insert calls, the difference to records is what got shared or freed
+        unsigned long long updates = 0;
+        unsigned long long released = 0; // records freed with their last handle
+    };
+
+    RecordStore() = default;
+    RecordStore(const RecordStore&) = delete;
+    RecordStore& operator=(const RecordStore&) = delete;
+
+    ~RecordStore() {
+        change_log.clear();
+        for (Slot* slot : slots) delete slot;
+    }
+
+    // the handle of key, storing record first if the key is new; an existing record is kept as it is
+    // since it may already carry more than record does. An empty key always gets a slot of its own.
+    Handle insert(const std::string& key, Record record) {
+        inserts++;
+        if (!key.empty()) {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = index.find(key);
+            if (it != index.end()) return Handle(it->second);
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (!key.empty()) {
+            auto it = index.find(key);
+            if (it != index.end()) return Handle(it->second);
+        }
+        Slot* slot = new Slot(this, key, std::make_shared<const Record>(std::move(record)));
+        slots.insert(slot);
+        if (!key.empty()) index.emplace(key, slot);
+        return Handle(slot);
+    }
+
+    // an empty handle when the key was never inserted
+    Handle find(const std::string& key) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = index.find(key);
+        return it == index.end() ? Handle() : Handle(it->second);
+    }
+
+    void publish(Handle handle, Record record) {
+        if (!handle) return;
+        std::lock_guard<std::mutex> lock(writer);
+        handle.slot->record.store(std::make_shared<const Record>(std::move(record)), std::memory_order_release);
+        changed(handle);
+    }
+
+    // fn(Record&) on a private copy of the current version, which is then published
+    template <typename Fn>
+    void update(Handle handle, Fn fn) {
+        if (!handle) return;
+        std::lock_guard<std::mutex> lock(writer);
+        auto next = std::make_shared<Record>(*handle.slot->record.load(std::memory_order_acquire));
+        fn(*next);
+        handle.slot->record.store(std::move(next), std::memory_order_release);
+        changed(handle);
+    }
+
+    // changes whenever a record is replaced, so views built from records know when they are stale
+    unsigned long long version() const {
+        return updates.load(std::memory_order_acquire);
+    }
+
+    // appends the handles replaced after version (one entry per replacement, oldest first); false
+    // when the log no longer reaches back that far and the caller has to assume everything changed
+    bool changed_since(unsigned long long version, std::vector<Handle>& out) const {
+        std::lock_guard<std::mutex> lock(writer);
+        unsigned long long current = updates.load();
+        if (current - version > change_log.size()) return false;
+        for (auto it = change_log.end() - (std::ptrdiff_t)(current - version); it != change_log.end(); ++it) {
+            out.push_back(*it);
+        }
+        return true;
+    }
+
+    Statistics statistics() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return { slots.size(), inserts.load(), updates.load(), released.load() };
+    }
+
+private:
+    // the last handle frees the slot; only that step takes the lock, other releases just count down
+    void release(Slot* slot) {
+        std::size_t handles = slot->handles.load(std::memory_order_relaxed);
+        while (handles > 1) {
+            if (slot->handles.compare_exchange_weak(handles, handles - 1, std::memory_order_acq_rel)) return;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (slot->handles.fetch_sub(1, std::memory_order_acq_rel) != 1) return; // copied or found meanwhile
+        if (!slot->key.empty()) index.erase(slot->key);
+        slots.erase(slot);
+        released++;
+        lock.unlock();
+        delete slot;
+    }
+
+    // writer held
+    void changed(const Handle& handle) {
+        change_log.push_back(handle);
+        if (change_log.size() > RECORD_STORE_CHANGE_LOG) change_log.pop_front();
+        updates++;
+    }
+
+    mutable std::shared_mutex mutex; // guards slots and index; taken after writer, never before it
+    mutable std::mutex writer; // serializes record replacements so concurrent updates are not lost, guards change_log
+    std::unordered_set<Slot*> slots; // every live slot, handles point at them
+    std::unordered_map<std::string, Slot*> index;
+    std::deque<Handle> change_log; // the last replacements, the newest at the back; keeps those records alive until they age out
+    std::atomic<unsigned long long> inserts{ 0 };
+    std::atomic<unsigned long long> updates{ 0 };
+    std::atomic<unsigned long long> released{ 0 };
+};
+
+#endif //FINALPROJECT_RECORD_STORE_H
@@ -0,0 +1,89 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_SHARDED_MAP_H
+#define FINALPROJECT_SHARDED_MAP_H
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <instrumented_mutex.h>
+
+// String keyed map split into independently locked shards, so threads working on different keys
+// do not wait for each other. Entries are only reached through callbacks that run under their
+// shard's lock; keep those short and never call back into the map from inside one.
+template <typename Value, std::size_t ShardCount = 16>
+class ShardedMap {
+private:
+    struct alignas(64) Shard {
+        InstrumentedMutex mutex;
+        std::unordered_map<std::string, Value> map;
+    };
+
+    Shard shards[ShardCount];
+
+    Shard& shard_for(const std::string& key) {
+        return shards[std::hash<std::string>{}(key) % ShardCount];
+    }
+
+public:
+    // fn(Value*) with nullptr when the key is missing, returns what fn returns
+    template <typename Fn>
+    auto with(const std::string& key, Fn fn) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+        auto it = shard.map.find(key);
+        return fn(it == shard.map.end() ? nullptr : &it->second);
+    }
+
+    // fn(Value&), the entry is value-initialized first when the key is missing
+    template <typename Fn>
+    auto update(const std::string& key, Fn fn) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+        return fn(shard.map[key]);
+    }
+
+    void set(const std::string& key, Value value) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+        shard.map[key] = std::move(value);
+    }
+
+    // erases the entry if pred(Value&) holds, returns whether it did
+    template <typename Pred>
+    bool erase_if(const std::string& key, Pred pred) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end() || !pred(it->second)) return false;
+        shard.map.erase(it);
+        return true;
+    }
+
+    // fn(key, Value&) for every entry, one shard locked at a time
+    template <typename Fn>
+    void for_each(Fn fn) {
+        for (auto& shard : shards) {
+            std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+            for (auto& entry : shard.map) {
+                fn(entry.first, entry.second);
+            }
+        }
+    }
+
+    InstrumentedMutex::Statistics lock_statistics() const {
+        InstrumentedMutex::Statistics total;
+        for (const auto& shard : shards) {
+            total += shard.mutex.statistics();
+        }
+        return total;
+    }
+};
+
+#endif //FINALPROJECT_SHARDED_MAP_H
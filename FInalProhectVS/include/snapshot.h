@@ -0,0 +1,60 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_SNAPSHOT_H
+#define FINALPROJECT_SNAPSHOT_H
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+// Read-copy-update holder for data the render thread reads every frame. Readers load an immutable
+// version with one atomic operation and keep it for as long as they need it; writers copy the
+// current version, change the copy and publish it with an atomic pointer swap. A version is freed
+// when the last reader holding it lets go, so nothing is reclaimed under a reader's feet.
+template <typename T>
+class Snapshot {
+private:
+    std::atomic<std::shared_ptr<const T>> current{ std::make_shared<const T>() };
+    std::mutex writer; // serializes writers so concurrent updates are not lost
+    std::atomic<unsigned long long> versions{ 0 };
+
+public:
+    std::shared_ptr<const T> load() const {
+        return current.load(std::memory_order_acquire);
+    }
+
+    void publish(T value) {
+        std::lock_guard<std::mutex> lock(writer);
+        current.store(std::make_shared<const T>(std::move(value)), std::memory_order_release);
+        versions++;
+    }
+
+    // fn(T&) on a private copy of the current version, which is then published; returns what fn returns
+    template <typename Fn>
+    auto update(Fn fn) {
+        std::lock_guard<std::mutex> lock(writer);
+        auto next = std::make_shared<T>(*current.load(std::memory_order_acquire));
+        if constexpr (std::is_void_v<decltype(fn(*next))>) {
+            fn(*next);
+            current.store(std::move(next), std::memory_order_release);
+            versions++;
+        }
+        else {
+            auto result = fn(*next);
+            current.store(std::move(next), std::memory_order_release);
+            versions++;
+            return result;
+        }
+    }
+
+    // number of versions published so far
+    unsigned long long version_count() const {
+        return versions.load();
+    }
+};
+
+#endif //FINALPROJECT_SNAPSHOT_H
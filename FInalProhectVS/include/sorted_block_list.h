@@ -0,0 +1,108 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_SORTED_BLOCK_LIST_H
+#define FINALPROJECT_SORTED_BLOCK_LIST_H
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Sorted sequence kept in blocks of at most 2 * BlockSize elements. An insert binary searches the
+// blocks and then one block and shifts only that block, so it costs O(log n) comparisons and
+// O(BlockSize) moves instead of shifting everything behind it like a sorted std::vector would.
+// Positional reads go through the block start positions, also O(log n). The ordering is passed to
+// every call that needs it, so it may look at data that lives outside the list.
+template <typename T, std::size_t BlockSize = 256>
+class SortedBlockList {
+private:
+    std::vector<std::vector<T>> blocks;
+    std::vector<std::size_t> starts; // position of the first element of every block
+    std::size_t count = 0;
+
+    void update_starts(std::size_t from) {
+        starts.resize(blocks.size());
+        for (std::size_t i = from; i < blocks.size(); ++i) {
+            starts[i] = i == 0 ? 0 : starts[i - 1] + blocks[i - 1].size();
+        }
+    }
+
+public:
+    // replaces the contents with values, which must already be sorted
+    void assign(const std::vector<T>& values) {
+        blocks.clear();
+        for (std::size_t first = 0; first < values.size(); first += BlockSize) {
+            std::size_t last = std::min(values.size(), first + BlockSize);
+            blocks.emplace_back(values.begin() + first, values.begin() + last);
+        }
+        count = values.size();
+        update_starts(0);
+    }
+
+    // inserts value in front of the first element that is not less than it
+    template <typename Less>
+    void insert(const T& value, Less less) {
+        if (blocks.empty()) {
+            blocks.emplace_back(1, value);
+            count = 1;
+            update_starts(0);
+            return;
+        }
+        auto block = std::partition_point(blocks.begin(), blocks.end(),
+            [&](const std::vector<T>& b) { return less(b.back(), value); });
+        if (block == blocks.end()) --block;
+        block->insert(std::lower_bound(block->begin(), block->end(), value, less), value);
+        ++count;
+
+        std::size_t index = (std::size_t)(block - blocks.begin());
+        if (block->size() > 2 * BlockSize) {
+            std::vector<T> upper(block->begin() + BlockSize, block->end());
+            block->resize(BlockSize);
+            blocks.insert(blocks.begin() + index + 1, std::move(upper));
+        }
+        update_starts(index);
+    }
+
+    // removes every element pred(element) holds for, returns how many; O(n)
+    template <typename Pred>
+    std::size_t erase_if(Pred pred) {
+        std::size_t removed = 0;
+        for (auto& block : blocks) {
+            auto end = std::remove_if(block.begin(), block.end(), pred);
+            removed += (std::size_t)(block.end() - end);
+            block.erase(end, block.end());
+        }
+        blocks.erase(std::remove_if(blocks.begin(), blocks.end(),
+            [](const std::vector<T>& b) { return b.empty(); }), blocks.end());
+        count -= removed;
+        update_starts(0);
+        return removed;
+    }
+
+    const T& operator[](std::size_t position) const {
+        std::size_t block = (std::size_t)(std::upper_bound(starts.begin(), starts.end(), position) - starts.begin()) - 1;
+        return blocks[block][position - starts[block]];
+    }
+
+    // position of the first element equal to value, size() when there is none; O(n)
+    std::size_t find(const T& value) const {
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            auto it = std::find(blocks[i].begin(), blocks[i].end(), value);
+            if (it != blocks[i].end()) return starts[i] + (std::size_t)(it - blocks[i].begin());
+        }
+        return count;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+};
+
+#endif //FINALPROJECT_SORTED_BLOCK_LIST_H
@@ -0,0 +1,85 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_STRING_POOL_H
+#define FINALPROJECT_STRING_POOL_H
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using StringId = std::uint32_t; // 0 is always the empty string
+
+// Interns strings that repeat across movies (genres, actors, directors) so a record only carries
+// 4-byte ids and every distinct string is stored once. Ids are stable for the life of the pool.
+class StringPool {
+public:
+    struct Statistics {
+        std::size_t strings = 0;
+        std::size_t bytes = 0;
+        unsigned long long lookups = 0; // intern calls, the difference to strings is what got shared
+    };
+
+    static StringPool& instance() {
+        static StringPool pool;
+        return pool;
+    }
+
+    StringPool() {
+        strings.emplace_back();
+        ids.emplace(std::string_view(strings.back()), 0);
+    }
+
+    StringId intern(std::string_view text) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            lookups++;
+            auto it = ids.find(text);
+            if (it != ids.end()) return it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto it = ids.find(text);
+        if (it != ids.end()) return it->second;
+        StringId id = static_cast<StringId>(strings.size());
+        strings.emplace_back(text); // deque: earlier strings, and the views keyed on them, never move
+        bytes += text.size();
+        ids.emplace(std::string_view(strings.back()), id);
+        return id;
+    }
+
+    // stays valid for the life of the pool
+    std::string_view view(StringId id) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return id < strings.size() ? std::string_view(strings[id]) : std::string_view();
+    }
+
+    Statistics statistics() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return { strings.size(), bytes, lookups.load() };
+    }
+
+private:
+    mutable std::shared_mutex mutex;
+    std::deque<std::string> strings; // indexed by id
+    std::unordered_map<std::string_view, StringId> ids;
+    std::size_t bytes = 0;
+    std::atomic<unsigned long long> lookups{ 0 };
+};
+
+inline StringId Intern(std::string_view text) {
+    return StringPool::instance().intern(text);
+}
+
+inline std::string_view Interned(StringId id) {
+    return StringPool::instance().view(id);
+}
+
+#endif //FINALPROJECT_STRING_POOL_H
@@ -0,0 +1,174 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_TASK_H
+#define FINALPROJECT_TASK_H
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <utility>
+#include <task_scheduler.h>
+
+// Lazily started coroutine returning T. co_await-ing a Task starts it and resumes the awaiting
+// coroutine when it finishes, on whatever thread it finished on; use ResumeOn to hop between the
+// worker pool and the render thread. Spawn starts a Task<void> nobody waits for. Once the scheduler
+// shuts down, co_await ResumeOn throws TaskCancelled, which unwinds every frame up to Spawn.
+//
+//     Task<void> Example() {
+//         co_await ResumeOn(task_scheduler, Executor::Worker); // blocking I/O from here on
+//         ...
+//         co_await ResumeOn(task_scheduler, Executor::MainThread); // back on the UI frame
+//     }
+template <typename T = void>
+class Task;
+
+// not a std::exception, so a catch (const std::exception&) in a coroutine lets it through
+struct TaskCancelled {};
+
+namespace task_detail {
+    struct PromiseBase {
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+        std::exception_ptr exception;
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                return handle.promise().continuation;
+            }
+            void await_resume() noexcept {}
+        };
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+    template <typename T>
+    struct Promise : PromiseBase {
+        std::optional<T> value;
+
+        Task<T> get_return_object();
+        void return_value(T result) { value = std::move(result); }
+        T result() {
+            if (exception) std::rethrow_exception(exception);
+            return std::move(*value);
+        }
+    };
+
+    template <>
+    struct Promise<void> : PromiseBase {
+        Task<void> get_return_object();
+        void return_void() {}
+        void result() {
+            if (exception) std::rethrow_exception(exception);
+        }
+    };
+}
+
+template <typename T>
+class Task {
+public:
+    using promise_type = task_detail::Promise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle) handle.destroy();
+    }
+
+    bool await_ready() const noexcept {
+        return !handle || handle.done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle; // symmetric transfer, starts the task on this thread
+    }
+
+    T await_resume() {
+        return handle.promise().result();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+namespace task_detail {
+    template <typename T>
+    Task<T> Promise<T>::get_return_object() {
+        return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+    }
+
+    inline Task<void> Promise<void>::get_return_object() {
+        return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+    }
+
+    // owns itself, the frame is freed when the coroutine finishes
+    struct Detached {
+        struct promise_type {
+            Detached get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept {}
+        };
+    };
+}
+
+// starts task on the calling thread and lets it run to completion on its own
+inline void Spawn(Task<void> task) {
+    [](Task<void> owned) -> task_detail::Detached {
+        try {
+            co_await owned;
+        }
+        catch (const TaskCancelled&) {
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Unhandled exception in task: " << e.what() << std::endl;
+        }
+    }(std::move(task));
+}
+
+// co_await ResumeOn(scheduler, executor) continues the coroutine on a pool worker or on the render
+// thread's next drain of the main-thread queue
+struct ResumeOn {
+    TaskScheduler& scheduler;
+    Executor executor;
+    TaskPriority priority = TaskPriority::Normal;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) const {
+        // a scheduler that was shut down does not take the task, await_resume cancels right here
+        // instead of leaking the frame
+        if (executor == Executor::MainThread) {
+            return scheduler.post_to_main([handle]() { handle.resume(); });
+        }
+        return scheduler.submit([handle]() { handle.resume(); }, priority);
+    }
+    void await_resume() const {
+        if (scheduler.stopped()) throw TaskCancelled{};
+    }
+};
+
+// suspends a coroutine running on the render thread until the next frame
+inline ResumeOn NextFrame(TaskScheduler& scheduler) {
+    return { scheduler, Executor::MainThread };
+}
+
+#endif //FINALPROJECT_TASK_H
@@ -0,0 +1,218 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_TASK_SCHEDULER_H
+#define FINALPROJECT_TASK_SCHEDULER_H
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <utility>
+#include <vector>
+
+enum class TaskPriority { Low = 0, Normal = 1, High = 2 };
+
+enum class Executor { Worker, MainThread };
+
+// Fixed pool of worker threads with one deque per worker and priority. A worker runs its own newest
+// task first and steals the oldest task of another worker when it runs dry; higher priorities
+// always go before lower ones, wherever they are queued. Work that has to touch UI state is posted
+// to the main-thread queue, which the render loop drains once per frame.
+class TaskScheduler {
+public:
+    using Task = std::function<void()>;
+
+    struct Statistics {
+        unsigned long long executed = 0;
+        unsigned long long stolen = 0;
+        unsigned long long main_thread_tasks = 0;
+    };
+
+    TaskScheduler() = default;
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    ~TaskScheduler() {
+        shutdown();
+    }
+
+    void start(unsigned int worker_count) {
+        worker_count = worker_count == 0 ? 1 : worker_count;
+        for (unsigned int i = 0; i < worker_count; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        for (unsigned int i = 0; i < worker_count; ++i) {
+            workers[i]->thread = std::thread(&TaskScheduler::run_worker, this, i);
+        }
+    }
+
+    // running tasks are waited for, then whatever is still queued, main-thread tasks included, runs
+    // on the calling thread, so call it from the render thread. Coroutines resumed there see
+    // stopped() and unwind (ResumeOn throws TaskCancelled) instead of leaking their frames.
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            if (stopping) return;
+            stopping = true;
+        }
+        sleep_cond.notify_all();
+        for (auto& worker : workers) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+        Task task;
+        while (take_queued_task(task)) {
+            task();
+            task = nullptr;
+        }
+    }
+
+    // true from the start of shutdown()
+    bool stopped() const {
+        return stopping.load();
+    }
+
+    // returns false, and drops the task, before start() and after shutdown(); callers that must not
+    // lose the work run it themselves then
+    bool submit(Task task, TaskPriority priority = TaskPriority::Normal) {
+        {
+            std::lock_guard<std::mutex> sleep_lock(sleep_mutex);
+            if (workers.empty() || stopping) return false;
+            std::size_t target = current_scheduler == this ? current_worker : next_worker++ % workers.size();
+            std::lock_guard<std::mutex> lock(workers[target]->mutex);
+            workers[target]->queues[static_cast<int>(priority)].push_back(std::move(task));
+        }
+        sleep_cond.notify_one();
+        return true;
+    }
+
+    // false, and drops the task, after shutdown() started
+    bool post_to_main(Task task) {
+        if (stopping) return false;
+        std::lock_guard<std::mutex> lock(main_mutex);
+        main_tasks.push_back(std::move(task));
+        return true;
+    }
+
+    // called by the render loop once per frame, returns how many tasks ran
+    std::size_t run_main_thread_tasks(std::size_t max = static_cast<std::size_t>(-1)) {
+        std::vector<Task> batch;
+        {
+            std::lock_guard<std::mutex> lock(main_mutex);
+            while (!main_tasks.empty() && batch.size() < max) {
+                batch.push_back(std::move(main_tasks.front()));
+                main_tasks.pop_front();
+            }
+        }
+        for (auto& task : batch) {
+            task();
+        }
+        main_thread_tasks += batch.size();
+        return batch.size();
+    }
+
+    unsigned int worker_count() const {
+        return static_cast<unsigned int>(workers.size());
+    }
+
+    Statistics statistics() const {
+        return { executed.load(), stolen.load(), main_thread_tasks.load() };
+    }
+
+private:
+    static constexpr int priority_count = 3;
+
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<Task> queues[priority_count]; // indexed by TaskPriority
+        std::thread thread;
+    };
+
+    bool find_task(std::size_t index, Task& task) {
+        for (int priority = priority_count - 1; priority >= 0; --priority) {
+            {
+                Worker& own = *workers[index];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.queues[priority].empty()) {
+                    task = std::move(own.queues[priority].back());
+                    own.queues[priority].pop_back();
+                    return true;
+                }
+            }
+            for (std::size_t offset = 1; offset < workers.size(); ++offset) {
+                Worker& victim = *workers[(index + offset) % workers.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.queues[priority].empty()) {
+                    task = std::move(victim.queues[priority].front());
+                    victim.queues[priority].pop_front();
+                    stolen++;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // shutdown(): any task left in a worker queue, then the main-thread queue
+    bool take_queued_task(Task& task) {
+        for (auto& worker : workers) {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            for (int priority = priority_count - 1; priority >= 0; --priority) {
+                if (!worker->queues[priority].empty()) {
+                    task = std::move(worker->queues[priority].front());
+                    worker->queues[priority].pop_front();
+                    return true;
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(main_mutex);
+        if (main_tasks.empty()) return false;
+        task = std::move(main_tasks.front());
+        main_tasks.pop_front();
+        return true;
+    }
+
+    void run_worker(std::size_t index) {
+        current_scheduler = this;
+        current_worker = index;
+        while (true) {
+            Task task;
+            if (!find_task(index, task)) {
+                // submit queues under sleep_mutex, so a task can not slip in between the last look
+                // and the wait; a worker woken for a task somebody else took goes back to sleep
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                sleep_cond.wait(lock, [&] { return stopping || find_task(index, task); });
+                if (!task) return;
+            }
+            task();
+            executed++;
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<std::size_t> next_worker{ 0 };
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cond;
+    std::atomic<bool> stopping{ false }; // written under sleep_mutex
+
+    std::mutex main_mutex;
+    std::deque<Task> main_tasks;
+
+    std::atomic<unsigned long long> executed{ 0 };
+    std::atomic<unsigned long long> stolen{ 0 };
+    std::atomic<unsigned long long> main_thread_tasks{ 0 };
+
+    static inline thread_local TaskScheduler* current_scheduler = nullptr;
+    static inline thread_local std::size_t current_worker = 0;
+};
+
+#endif //FINALPROJECT_TASK_SCHEDULER_H
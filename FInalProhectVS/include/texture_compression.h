@@ -0,0 +1,155 @@
+//
+// Created by user on 10/18/2026.
+//
+
+#ifndef FINALPROJECT_TEXTURE_COMPRESSION_H
+#define FINALPROJECT_TEXTURE_COMPRESSION_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+// CPU side BC1 (DXT1) encoder. Every 4x4 pixel block becomes 8 bytes: two RGB565 endpoints
+// and sixteen 2 bit indices into the palette { c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1 }.
+// Nothing in here touches OpenGL, so it can run on any thread.
+
+inline std::size_t Bc1Size(int width, int height) {
+    return static_cast<std::size_t>((width + 3) / 4) * static_cast<std::size_t>((height + 3) / 4) * 8;
+}
+
+inline uint16_t PackRgb565(int r, int g, int b) {
+    return static_cast<uint16_t>(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+inline void UnpackRgb565(uint16_t color, int rgb[3]) {
+    int r = (color >> 11) & 31;
+    int g = (color >> 5) & 63;
+    int b = color & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// block holds 16 pixels in RGB order, out receives 8 bytes
+inline void CompressBc1Block(const unsigned char block[16][3], unsigned char out[8]) {
+    int low[3] = { 255, 255, 255 };
+    int high[3] = { 0, 0, 0 };
+    int mean[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            low[c] = std::min(low[c], static_cast<int>(block[i][c]));
+            high[c] = std::max(high[c], static_cast<int>(block[i][c]));
+            mean[c] += block[i][c];
+        }
+    }
+    for (int c = 0; c < 3; ++c) {
+        mean[c] /= 16;
+    }
+
+    // the bounding box always runs from low to high along red, flip green and blue when they fall as red rises
+    long long covariance_g = 0;
+    long long covariance_b = 0;
+    for (int i = 0; i < 16; ++i) {
+        int r = block[i][0] - mean[0];
+        covariance_g += r * (block[i][1] - mean[1]);
+        covariance_b += r * (block[i][2] - mean[2]);
+    }
+    if (covariance_g < 0) std::swap(low[1], high[1]);
+    if (covariance_b < 0) std::swap(low[2], high[2]);
+
+    // inset the box a little, the extremes are usually outliers
+    for (int c = 0; c < 3; ++c) {
+        int inset = (high[c] - low[c]) / 16;
+        low[c] += inset;
+        high[c] -= inset;
+    }
+
+    uint16_t color0 = PackRgb565(high[0], high[1], high[2]);
+    uint16_t color1 = PackRgb565(low[0], low[1], low[2]);
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        int palette[4][3];
+        UnpackRgb565(color0, palette[0]);
+        UnpackRgb565(color1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int best_distance = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                int distance = 0;
+                for (int c = 0; c < 3; ++c) {
+                    int d = block[i][c] - palette[p][c];
+                    distance += d * d;
+                }
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint32_t>(best) << (2 * i);
+        }
+    }
+
+    out[0] = static_cast<unsigned char>(color0 & 0xFF);
+    out[1] = static_cast<unsigned char>(color0 >> 8);
+    out[2] = static_cast<unsigned char>(color1 & 0xFF);
+    out[3] = static_cast<unsigned char>(color1 >> 8);
+    for (int i = 0; i < 4; ++i) {
+        out[4 + i] = static_cast<unsigned char>((indices >> (8 * i)) & 0xFF);
+    }
+}
+
+// inverse of CompressBc1Block, used to check the encoder; block receives 16 pixels in RGB order
+inline void DecompressBc1Block(const unsigned char in[8], unsigned char block[16][3]) {
+    uint16_t color0 = static_cast<uint16_t>(in[0] | in[1] << 8);
+    uint16_t color1 = static_cast<uint16_t>(in[2] | in[3] << 8);
+    int palette[4][3];
+    UnpackRgb565(color0, palette[0]);
+    UnpackRgb565(color1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        // the encoder never emits color0 < color1, so the 3 color + transparent mode only shows up as color0 == color1
+        palette[2][c] = color0 > color1 ? (2 * palette[0][c] + palette[1][c]) / 3 : (palette[0][c] + palette[1][c]) / 2;
+        palette[3][c] = color0 > color1 ? (palette[0][c] + 2 * palette[1][c]) / 3 : 0;
+    }
+    uint32_t indices = static_cast<uint32_t>(in[4]) | static_cast<uint32_t>(in[5]) << 8
+        | static_cast<uint32_t>(in[6]) << 16 | static_cast<uint32_t>(in[7]) << 24;
+    for (int i = 0; i < 16; ++i) {
+        int index = (indices >> (2 * i)) & 3;
+        for (int c = 0; c < 3; ++c) {
+            block[i][c] = static_cast<unsigned char>(palette[index][c]);
+        }
+    }
+}
+
+// pixels are tightly packed rows with 3 or 4 channels (alpha is dropped), out must hold Bc1Size(width, height) bytes
+inline void CompressBc1(const unsigned char* pixels, int width, int height, int channels, unsigned char* out) {
+    unsigned char block[16][3];
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            for (int y = 0; y < 4; ++y) {
+                // edge blocks repeat the last row / column
+                int py = std::min(by + y, height - 1);
+                for (int x = 0; x < 4; ++x) {
+                    int px = std::min(bx + x, width - 1);
+                    const unsigned char* pixel = pixels + (static_cast<std::size_t>(py) * width + px) * channels;
+                    block[y * 4 + x][0] = pixel[0];
+                    block[y * 4 + x][1] = channels >= 3 ? pixel[1] : pixel[0];
+                    block[y * 4 + x][2] = channels >= 3 ? pixel[2] : pixel[0];
+                }
+            }
+            CompressBc1Block(block, out);
+            out += 8;
+        }
+    }
+}
+
+#endif //FINALPROJECT_TEXTURE_COMPRESSION_H
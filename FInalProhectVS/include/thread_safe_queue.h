@@ -8,6 +8,8 @@
 #pragma once
 
 #include <queue>
+#include <vector>
+#include <chrono>
 #include <mutex>
 #include <condition_variable>
 
@@ -17,18 +19,29 @@ private:
     std::queue<T> queue;
     mutable std::mutex mutex;
     std::condition_variable cond;
+    std::condition_variable not_full;
+    std::size_t capacity = 0; // 0 means unbounded
     bool finished = false;
 
 public:
+    ThreadSafeQueue() = default;
+    explicit ThreadSafeQueue(std::size_t capacity) : capacity(capacity) {}
+
     bool is_finished() const {
         std::lock_guard<std::mutex> lock(mutex);
         return finished;
     }
 
-    void push(T value) {
-        std::lock_guard<std::mutex> lock(mutex);
+    // blocks while a bounded queue is full, returns false if the queue was finished while waiting
+    bool push(T value) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this] { return capacity == 0 || queue.size() < capacity || finished; });
+        if (capacity != 0 && queue.size() >= capacity) {
+            return false;
+        }
         queue.push(std::move(value));
         cond.notify_one();
+        return true;
     }
 
     bool pop(T& value) {
@@ -39,6 +52,46 @@ public:
         }
         value = std::move(queue.front());
         queue.pop();
+        not_full.notify_one();
+        return true;
+    }
+
+    // waits up to timeout, returns false on timeout or once the queue is finished and empty
+    template <typename Rep, typename Period>
+    bool pop_for(T& value, const std::chrono::duration<Rep, Period>& timeout) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!cond.wait_for(lock, timeout, [this] { return !queue.empty() || finished; }) || queue.empty()) {
+            return false;
+        }
+        value = std::move(queue.front());
+        queue.pop();
+        not_full.notify_one();
+        return true;
+    }
+
+    // moves up to max queued values to the back of out without waiting, returns how many were moved
+    std::size_t drain_into(std::vector<T>& out, std::size_t max) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t moved = 0;
+        while (!queue.empty() && moved < max) {
+            out.push_back(std::move(queue.front()));
+            queue.pop();
+            ++moved;
+        }
+        if (moved > 0) {
+            not_full.notify_all();
+        }
+        return moved;
+    }
+
+    bool try_pop(T& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) {
+            return false;
+        }
+        value = std::move(queue.front());
+        queue.pop();
+        not_full.notify_one();
         return true;
     }
 
@@ -46,6 +99,7 @@ public:
         std::lock_guard<std::mutex> lock(mutex);
         finished = true;
         cond.notify_all();
+        not_full.notify_all();
     }
 
     bool empty() const {
@@ -53,12 +107,18 @@ public:
         return queue.empty();
     }
 
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queue.size();
+    }
+
     void clear() {
         std::lock_guard<std::mutex> lock(mutex);
         while (!queue.empty()) {
             queue.pop();
         }
         finished = false;
+        not_full.notify_all();
     }
 };
 #endif //FINALPROJECT_THREAD_SAFE_QUEUE_H
@@ -1,4 +1,3 @@
-#define STB_IMAGE_IMPLEMENTATION
 #define CPPHTTPLIB_OPENSSL_SUPPORT
 
 
@@ -6,10 +5,33 @@
 #include <string>
 
 #include <thread>
+#include <chrono>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <climits>
 #include <thread_safe_queue.h>
+#include <mpmc_ring_queue.h>
+#include <priority_thread_safe_queue.h>
+#include <texture_compression.h>
+#include <pixel_arena.h>
+#include <image_decode.h>
+#include <mipmap.h>
+#include <image_work_queue.h>
+#include <http_client_pool.h>
+#include <rate_limiter.h>
+#include <task_scheduler.h>
+#include <task.h>
+#include <instrumented_mutex.h>
+#include <sharded_map.h>
+#include <snapshot.h>
+#include <string_pool.h>
+#include <movie.h>
+#include <movie_sort.h>
+#include <record_store.h>
+#include <sorted_block_list.h>
+#include <append_log.h>
+#include <kv_store.h>
 
 #include <queue>
 #include <map>
@@ -23,7 +45,6 @@
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
-#include <stb_image.h>
 
 #include <json.hpp>
 #include <httplib.h>
@@ -37,21 +58,43 @@ using json = nlohmann::json;
 #define SPECIAL_FONT "include/ImGui/misc/fonts/Pacifico-Regular.ttf"
 
 #define USER_DIRECTORY "./users/"
+#define USER_STORE_FILE "users.db" // in USER_DIRECTORY, see OpenUserStore for the keys
+#define POSTER_CACHE_DIRECTORY "./cache/posters/"
 #define FONT_SIZE 24.0f
-
-struct Movie {
-    std::string id;
-    std::string title;
-    std::string producer;
-    std::string release_year;
-    std::string runtime;
-    std::vector<std::string> genres;
-    std::vector<std::string> cast;
-    std::string poster_url;
-    GLuint texture_id = 0;
-    std::string rating;
-    std::string votes;
-    bool in_watch_list = false;
+#define DETAIL_POSTER_WIDTH 200.0f
+#define DETAIL_POSTER_HEIGHT 300.0f
+
+#define IMAGE_IO_THREADS 4
+#define IMAGE_CONNECTIONS_PER_ORIGIN 4
+#define IMAGE_STAGE_CAPACITY 8
+#define MAX_UPLOADS_PER_FRAME 4
+#define MOVIE_TABLE_COLUMNS 5 // one per SortColumn
+#define MAX_MOVIES_PER_FRAME 64
+#define LIST_ORDER_MAX_REPOSITION 16 // more changed records than this in one frame re-sort the list instead
+#define STAGE_AGING_MS 250 // low priority work waiting longer than this gets a share of the pops
+#define WATCH_LIST_WARM_TASKS 2 // leaves the rest of the task pool free for clicks while the warm up waits on the rate limiter
+#define OMDB_REQUESTS_PER_SECOND 5.0
+#define OMDB_REQUEST_BURST 5.0
+#define FAILED_POSTER_TRANSIENT_BACKOFF 30 // seconds, doubled on every further failure
+#define FAILED_POSTER_PERMANENT_BACKOFF 3600
+#define FAILED_POSTER_MAX_BACKOFF (7 * 24 * 3600)
+#define POSTER_CACHE_MAX_BYTES (256ull * 1024 * 1024) // least recently used .bc1 files go once the cache grows past this
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
+using MovieHandle = RecordStore<Movie>::Handle; // what lists and the selection hold, see movie_store
+using MovieRows = std::vector<MovieHandle>; // a result list or watch list version
+
+struct ListOrder { // sorted permutations of one list version, cached per sort spec; render thread only
+    std::shared_ptr<const MovieRows> rows; // the version the permutations belong to
+    unsigned long long store_version = 0; // movie_store.version() the records are current for
+    std::vector<std::shared_ptr<const Movie>> records; // rows loaded once per version, the tables draw from these
+    std::map<std::uint64_t, SortedBlockList<std::uint32_t>> orders; // row indices by EncodeSortSpec
+};
+struct SortedView { // rows of a list in display order
+    const SortedBlockList<std::uint32_t>* order = nullptr;
 };
 
 enum class ImageState {
@@ -61,6 +104,55 @@ enum class ImageState {
     Error
 };
 
+// Amazon serves resized poster variants, the width is picked per display context
+enum class PosterSize {
+    Thumbnail,
+    List,
+    Detail,
+    Large
+};
+
+// Poster loading runs in three stages: download (I/O threads) -> decode (CPU threads) -> upload (render thread)
+struct DownloadedImage {
+    std::string url;
+    std::vector<unsigned char> body; // borrowed from body_buffers, handed back after decoding
+    std::chrono::steady_clock::time_point queued;
+    int priority = 0; // PosterPriority it was queued with
+};
+
+struct DecodedImage {
+    std::string url;
+    unsigned char* data = nullptr;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    std::vector<unsigned char> compressed{}; // BC1 blocks of every level, used instead of data when texture compression is on
+    unsigned char* mip_data = nullptr; // levels 1.. back to back, see mipmap.h
+    int mip_levels = 1;
+    std::chrono::steady_clock::time_point queued{};
+    int priority = 0;
+};
+
+struct StageMetrics {
+    std::atomic<unsigned long long> items{ 0 };
+    std::atomic<unsigned long long> wait_microseconds{ 0 }; // time spent in the queue in front of the stage
+    std::atomic<unsigned long long> work_microseconds{ 0 };
+    std::atomic<unsigned int> max_depth{ 0 };
+};
+
+enum class PosterPriority {
+    Prefetch = 0,
+    Visible = 1 // drawn this frame
+};
+enum class ResultPriority { Other = 0, ExactTitle = 1 }; // search rows whose title is exactly the query are shown first
+
+struct FailedPosterUrl {
+    int status = 0; // HTTP status, 0 when there was no response and 200 when the image did not decode
+    int failures = 0;
+    long long retry_at = 0; // seconds since epoch
+};
+enum class PosterBackoff { None, Waiting, RetryDue }; // where a url stands in the failed poster cache
+
 struct ImageData {
     unsigned char* data = nullptr;
     int width = 0;
@@ -68,36 +160,99 @@ struct ImageData {
     int channels = 0;
     GLuint texture_id = 0;
     ImageState state = ImageState::NotLoaded;
+    std::vector<unsigned char> compressed{};
+    unsigned char* mip_data = nullptr;
+    int mip_levels = 1;
 };
 
 // Global variables of the project:
 
+// one record per imdbID, replaced as a whole when details arrive; defined before every global that
+// holds handles, so it is destroyed after them
+RecordStore<Movie> movie_store;
+
 // threads
-std::mutex mtx;
-std::condition_variable cv;
-ThreadSafeQueue<Movie> movie_queue;
+PriorityThreadSafeQueue<MovieHandle> movie_queue(2, std::chrono::milliseconds(STAGE_AGING_MS));
 std::atomic<bool> image_thread_running(true);
 std::atomic<bool> search_in_progress(false);
 std::atomic<bool> fetch_in_progress(false);
+unsigned int detail_request = 0; // render thread only, newest detail fetch, older results are not shown
+struct UserStoreWrite { // one change waiting for the task pool
+    std::string key;
+    std::string value;
+    bool erase = false;
+    std::string release_movie{}; // id whose movie/ record goes once no ref/ key holds it anymore
+};
+std::mutex user_store_mtx; // guards user_store, taken before user_store_writes_mtx
+KvStore user_store; // every user and watch list, USER_STORE_FILE
+std::mutex user_store_writes_mtx;
+std::vector<UserStoreWrite> user_store_writes; // in the order they were made, guarded by user_store_writes_mtx
+struct DetailChainMetrics { // click -> details -> poster on screen, render thread only
+    unsigned long long chains = 0;
+    unsigned long long posters = 0;
+    double fetch_ms = 0;
+    double poster_ms = 0;
+} detail_chain_metrics;
+TaskScheduler task_scheduler; // background work, results come back through the main-thread queue
+
+// image pipeline
+MpmcRingQueue<DownloadedImage> download_queue(IMAGE_STAGE_CAPACITY);
+PriorityThreadSafeQueue<DecodedImage> upload_queue(2, std::chrono::milliseconds(STAGE_AGING_MS), IMAGE_STAGE_CAPACITY); // indexed by PosterPriority
+StageMetrics download_metrics;
+StageMetrics decode_metrics;
+StageMetrics upload_metrics;
+HttpClientPool image_clients(IMAGE_CONNECTIONS_PER_ORIGIN); // keep-alive connections shared by the download threads
+ByteBufferPool body_buffers;
+std::atomic<unsigned long long> body_buffer_growths(0);
+ByteBufferPool block_buffers; // BC1 mip chains, handed back once the texture is uploaded
+std::atomic<unsigned long long> block_buffer_growths(0);
+bool compress_poster_textures = true; // encode posters to BC1 on the decode threads and keep them on disk
+std::atomic<bool> use_compressed_textures(false); // compress_poster_textures and the driver supports S3TC
+std::atomic<unsigned long long> poster_cache_bytes(0); // size of the .bc1 files, recounted by TrimPosterCache
+std::atomic<bool> poster_cache_trimming(false);
+
+std::map<std::string, FailedPosterUrl> failed_poster_urls;
+InstrumentedMutex failed_poster_urls_mtx;
+unsigned long long failed_poster_urls_version = 0; // bumped on every change, guarded by failed_poster_urls_mtx
+std::mutex failed_poster_urls_file_mtx; // one writer of the file at a time, taken before failed_poster_urls_mtx
+unsigned long long failed_poster_urls_written = 0; // version in the file, guarded by failed_poster_urls_file_mtx
 
 // movie
-std::queue<std::string> image_queue;
-std::map<std::string, ImageData> textureMap;
+ImageWorkQueue image_queue;
+std::atomic<unsigned int> search_generation(0); // bumped by every new search, older queued posters get cancelled
+InstrumentedMutex search_mtx; // held while a search publishes results, so an older search can not leak into a newer one
+ShardedMap<ImageData> textures; // keyed by the sized poster url, so one movie can have several resolutions
 std::string image_url;
+std::atomic<PosterSize> detail_poster_size(PosterSize::Detail);
 
-std::vector<Movie> watch_list;
-std::set<std::string> watch_list_titles;
+Snapshot<MovieRows> watch_list; // written through update() / publish(), the render thread reads one version per frame
+std::map<std::string, std::uint64_t> watch_list_titles; // id -> position in its user store key
+std::uint64_t watch_list_next_position = 0; // render thread, positions only grow so new movies sort last
 bool movie_not_found = false;
-Movie selected_movie;
+MovieHandle selected_movie;
 int selected_movie_index = -1;
-std::vector<Movie> movie_list;
+Snapshot<MovieRows> movie_list;
 bool show_not_in_list_message = false;
 enum class SelectedList { None, SearchResults, WatchList };
 SelectedList current_selected_list = SelectedList::None;
-bool sort_watch_list_by_year = false;
-bool sort_watch_list_ascending = true;
-bool sort_movie_list_by_year = false;
-bool sort_movie_list_ascending = true;
+SortSpec watch_list_sort = { { SortColumn::Title, true } };
+SortSpec movie_list_sort = { { SortColumn::Title, true } };
+ListOrder watch_list_order;
+ListOrder movie_list_order;
+struct SortMetrics { // render thread only
+    unsigned long long permutations = 0;
+    unsigned long long rows = 0;
+    unsigned long long repositioned = 0; // rows moved in place after their record changed
+    unsigned long long inserted = 0; // streamed rows sorted into an existing permutation
+    double total_ms = 0;
+    double max_ms = 0;
+} sort_metrics;
+
+// watch list warm up
+std::atomic<unsigned int> watch_list_warm_generation(0); // bumped on logout / new login, stops the running warm up
+std::atomic<int> watch_list_warm_total(0);
+std::atomic<int> watch_list_warm_done(0);
+RateLimiter omdb_rate_limiter(OMDB_REQUESTS_PER_SECOND, OMDB_REQUEST_BURST);
 
 // user and window 
 GLFWwindow* window;
@@ -148,123 +303,320 @@ void LoadFonts(ImGuiIO& io) {
 
     io.Fonts->Build();
 }
+void CancelStalePosterDownloads();
+void StartSearchSession();
 void ResetApplication() {
     first_run = true;
-    movie_list.clear();
-    selected_movie = Movie();
+    StartSearchSession();
+    selected_movie = MovieHandle();
     image_url.clear();
     movie_not_found = false;
     connection_error = false;
     selected_movie_index = -1;
     search_in_progress.store(false);
-    movie_queue.clear();
+    {
+        std::lock_guard<InstrumentedMutex> lock(search_mtx);
+        movie_queue.clear();
+        CancelStalePosterDownloads();
+    }
     memset(title_input, 0, sizeof(title_input));
     memset(year_input, 0, sizeof(year_input));
     show_not_in_list_message = false;
-    std::queue<std::string> empty;
-    std::swap(image_queue, empty);
+}
+
+// Poster urls
+int PosterWidth(PosterSize size) {
+    switch (size) {
+    case PosterSize::Thumbnail: return 64;
+    case PosterSize::List: return 128;
+    case PosterSize::Detail: return 300;
+    case PosterSize::Large: return 600;
+    }
+    return 300;
+}
+PosterSize PosterSizeFor(float pixel_width, float pixel_height) {
+    // posters are 2:3, a box wider than that is limited by its height
+    float width = std::min(pixel_width, pixel_height * 2.0f / 3.0f);
+    for (PosterSize size : { PosterSize::Thumbnail, PosterSize::List, PosterSize::Detail }) {
+        if (PosterWidth(size) >= width) {
+            return size;
+        }
+    }
+    return PosterSize::Large;
+}
+std::string BuildPosterUrl(const std::string& url, PosterSize size) {
+    // OMDb posters look like ".../images/M/<id>._V1_SX300.jpg", the part after "._V1_" is the resize directive
+    std::size_t directive = url.rfind("._V1_");
+    std::size_t extension = url.rfind('.');
+    if (directive == std::string::npos || extension == std::string::npos || extension < directive + 5) {
+        return url;
+    }
+    return url.substr(0, directive) + "._V1_SX" + std::to_string(PosterWidth(size)) + url.substr(extension);
+}
+std::string DetailPosterUrl(const std::string& url) {
+    return BuildPosterUrl(url, detail_poster_size.load());
+}
+
+// Negative cache of poster urls that failed, retried with exponential backoff
+fs::path FailedPosterUrlsPath() {
+    return fs::path(GetExecutablePath()) / POSTER_CACHE_DIRECTORY / "failed_posters.txt";
+}
+void WriteFailedPosterUrls() { // any thread: writes the newest version of the set unless the file has it already
+    std::lock_guard<std::mutex> file_lock(failed_poster_urls_file_mtx);
+    std::map<std::string, FailedPosterUrl> snapshot;
+    unsigned long long version;
+    {
+        std::lock_guard<InstrumentedMutex> lock(failed_poster_urls_mtx);
+        if (failed_poster_urls_version == failed_poster_urls_written) return;
+        snapshot = failed_poster_urls;
+        version = failed_poster_urls_version;
+    }
+    std::error_code ec;
+    fs::create_directories(FailedPosterUrlsPath().parent_path(), ec);
+    std::ofstream file(FailedPosterUrlsPath(), std::ios::trunc);
+    if (file.is_open()) {
+        for (const auto& [url, failure] : snapshot) {
+            file << failure.status << "|" << failure.failures << "|" << failure.retry_at << "|" << url << "\n";
+        }
+    }
+    failed_poster_urls_written = version;
+}
+void SaveFailedPosterUrls() { // after a change, without failed_poster_urls_mtx: the file is written on the task pool
+    if (!task_scheduler.submit([] { WriteFailedPosterUrls(); }, TaskPriority::Low)) {
+        WriteFailedPosterUrls();
+    }
+}
+void LoadFailedPosterUrls() {
+    std::lock_guard<InstrumentedMutex> lock(failed_poster_urls_mtx);
+    failed_poster_urls.clear();
+    std::ifstream file(FailedPosterUrlsPath());
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::string status, failures, retry_at, url;
+        if (std::getline(iss, status, '|') && std::getline(iss, failures, '|') && std::getline(iss, retry_at, '|') && std::getline(iss, url)) {
+            try {
+                failed_poster_urls[url] = { std::stoi(status), std::stoi(failures), std::stoll(retry_at) };
+            }
+            catch (const std::exception&) {
+                logError("Skipping malformed failed poster entry: " + line);
+            }
+        }
+    }
+}
+void RecordPosterFailure(const std::string& url, int status) {
+    // 404/410 and undecodable images will not fix themselves soon, timeouts and 5xx might
+    bool permanent = status == 404 || status == 410 || status == 200;
+    long long base_seconds = permanent ? FAILED_POSTER_PERMANENT_BACKOFF : FAILED_POSTER_TRANSIENT_BACKOFF;
+
+    {
+        std::lock_guard<InstrumentedMutex> lock(failed_poster_urls_mtx);
+        FailedPosterUrl& failure = failed_poster_urls[url];
+        failure.status = status;
+        failure.failures++;
+        long long backoff = base_seconds << std::min(failure.failures - 1, 16);
+        failure.retry_at = (long long)time(0) + std::min(backoff, (long long)FAILED_POSTER_MAX_BACKOFF);
+        failed_poster_urls_version++;
+    }
+    SaveFailedPosterUrls();
+}
+void RecordPosterSuccess(const std::string& url) {
+    {
+        std::lock_guard<InstrumentedMutex> lock(failed_poster_urls_mtx);
+        if (failed_poster_urls.erase(url) == 0) return;
+        failed_poster_urls_version++;
+    }
+    SaveFailedPosterUrls();
+}
+PosterBackoff FailedPosterBackoff(const std::string& url) {
+    if (url.empty() || url == "N/A") return PosterBackoff::Waiting; // never worth a request
+    std::lock_guard<InstrumentedMutex> lock(failed_poster_urls_mtx);
+    auto it = failed_poster_urls.find(url);
+    if (it == failed_poster_urls.end()) return PosterBackoff::None;
+    return (long long)time(0) < it->second.retry_at ? PosterBackoff::Waiting : PosterBackoff::RetryDue;
+}
+void QueuePosterDownload(const std::string& url, PosterPriority priority = PosterPriority::Prefetch, bool keep_across_searches = false) { // any thread
+    unsigned int generation = keep_across_searches ? UINT_MAX : search_generation.load();
+    PosterBackoff backoff = FailedPosterBackoff(url); // looked up first, failed_poster_urls_mtx is never taken under a shard lock
+    textures.update(url, [&](ImageData& image) {
+        switch (image.state) {
+        case ImageState::Loading:
+            // still waiting in the queue: move it up and keep it alive for the current search
+            image_queue.reprioritize(url, (int)priority, generation);
+            return;
+        case ImageState::Loaded:
+            return;
+        case ImageState::Error:
+            if (backoff != PosterBackoff::RetryDue) return;
+            break;
+        case ImageState::NotLoaded:
+            if (backoff == PosterBackoff::Waiting) {
+                // known dead link, never reaches the loader until its backoff runs out
+                image.state = ImageState::Error;
+                return;
+            }
+            break;
+        }
+        image = ImageData();
+        image.state = ImageState::Loading;
+        image_queue.push(url, (int)priority, generation);
+    });
+}
+void CancelStalePosterDownloads() {
+    // forget posters queued for previous searches, they get queued again if they show up on screen
+    std::vector<std::string> cancelled = image_queue.cancel_older_than(++search_generation);
+    for (const auto& url : cancelled) {
+        textures.erase_if(url, [](const ImageData& image) { return image.state == ImageState::Loading; });
+    }
+}
+Task<ImageState> WaitForPoster(std::string url) { // render thread, finishes once the poster is on the GPU or failed
+    QueuePosterDownload(url, PosterPriority::Visible);
+    while (true) {
+        ImageState state = textures.with(url, [](const ImageData* image) {
+            return image != nullptr ? image->state : ImageState::NotLoaded; // missing: cancelled by a new search
+        });
+        if (state != ImageState::Loading) co_return state;
+        co_await NextFrame(task_scheduler);
+    }
 }
 
 // Movie
 bool IsInWatchList(const std::string& id) {
     return watch_list_titles.find(id) != watch_list_titles.end();
 }
-void FetchMovieList(const std::string& title, const std::string& year) {
-    std::string encoded_title = httplib::detail::encode_url(title);
-    std::string url = "/?s=" + encoded_title + "&type=movie&apikey=" + api_key;
-
+// every OMDb request goes through here, so searches, detail fetches and the warm up share one budget
+httplib::Result OmdbGet(const std::string& url) {
+    omdb_rate_limiter.acquire();
     httplib::Client cli("https://www.omdbapi.com");
-    auto res = cli.Get(url);
-
-    if (!res) {
-        connection_error = true;
-        movie_queue.setFinished();
-        return;
-    }
-
-    if (res->status == 200) {
-        json response = json::parse(res->body);
-        if (response["Response"] == "True" && response.contains("Search")) {
-            for (const auto& item : response["Search"]) {
-                Movie movie;
-                movie.id = item.value("imdbID", "");
-                movie.title = item.value("Title", "Unknown");
-                movie.release_year = item.value("Year", "Unknown");
-                movie.poster_url = item.value("Poster", "");
-
-                // Apply year filter here if specified
-                if (year.empty() || movie.release_year.find(year) != std::string::npos) {
-                    movie_queue.push(movie);
+    return cli.Get(url);
+}
+void FetchMovieList(const std::string& title, const std::string& year, unsigned int generation) { // task pool
+    auto publish = [generation](auto&& action) { // drops the results of a search that was replaced meanwhile
+        std::lock_guard<InstrumentedMutex> lock(search_mtx);
+        if (search_generation.load() == generation) {
+            action();
+        }
+    };
+
+    // every path below ends in setFinished, or the frame loop would show "Searching..." forever
+    try {
+        std::string encoded_title = httplib::detail::encode_url(title);
+        std::string url = "/?s=" + encoded_title + "&type=movie&apikey=" + api_key;
+
+        auto res = OmdbGet(url);
+
+        if (!res) {
+            publish([] { connection_error = true; });
+        }
+        else if (res->status == 200) {
+            // an HTML error page or a cut off body is not JSON, treat it like a failed request
+            json response = json::parse(res->body, nullptr, false);
+            if (response.is_discarded() || !response.is_object()) {
+                logError("Malformed search response for: " + title);
+                publish([] { connection_error = true; });
+            }
+            else if (response.value("Response", "") == "True" && response.contains("Search") && response["Search"].is_array()) {
+                MovieRows exact, other;
+                std::string query = title;
+                std::transform(query.begin(), query.end(), query.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+                for (const auto& item : response["Search"]) {
+                    if (!item.is_object()) continue;
+                    Movie movie;
+                    movie.id = item.value("imdbID", "");
+                    SetTitle(movie, item.value("Title", "Unknown"));
+                    std::string release_year = item.value("Year", "");
+                    ParseYearRange(release_year, movie);
+                    movie.poster_url = item.value("Poster", "");
+
+                    // Apply year filter here if specified
+                    if (year.empty() || release_year.find(year) != std::string::npos) {
+                        std::string folded = movie.title;
+                        std::transform(folded.begin(), folded.end(), folded.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+                        std::string id = movie.id;
+                        (folded == query ? exact : other).push_back(movie_store.insert(id, std::move(movie)));
+                    }
                 }
+                publish([&] { // the whole page under one lock
+                    movie_queue.push_batch(exact, (int)ResultPriority::ExactTitle);
+                    movie_queue.push_batch(other, (int)ResultPriority::Other);
+                });
+                publish([] { connection_error = false; });
+            }
+            else {
+                // No movies found or error in response
+                publish([] {
+                    connection_error = false; // It's not a connection error, just no results
+                    movie_not_found = true;
+                });
             }
-            connection_error = false;
         }
         else {
-            // No movies found or error in response
-            connection_error = false; // It's not a connection error, just no results
-            movie_not_found = true;
+            publish([] { connection_error = true; });
         }
     }
-    else {
-        connection_error = true;
+    catch (const std::exception& e) {
+        // a field of an unexpected type, or the client itself failing
+        logError("Exception in FetchMovieList for: " + title + ". Error: " + e.what());
+        publish([] { connection_error = true; });
     }
 
-    movie_queue.setFinished();
+    publish([] { movie_queue.setFinished(); });
+}
+Task<void> RunSearch(std::string title, std::string year, unsigned int generation) {
+    co_await ResumeOn{ task_scheduler, Executor::Worker, TaskPriority::High };
+    FetchMovieList(title, year, generation); // rows stream to the frame loop through movie_queue
+}
+// render thread: drops the previous result set and its sort cache and starts an empty one
+void StartSearchSession() {
+    movie_list_order = ListOrder();
+    movie_list.publish({});
 }
-bool FetchMovieInfo(Movie& movie) { // info of a spesific movie 
+bool FetchMovieInfo(Movie& movie, bool update_globals = true) { // info of a spesific movie, update_globals=false leaves image_url and connection_error alone 
     try {
         std::string encoded_title = httplib::detail::encode_url(movie.title);
-        std::string url = "/?t=" + encoded_title + "&y=" + movie.release_year + "&apikey=" + api_key;
+        std::string url = "/?t=" + encoded_title + (movie.year_from != 0 ? "&y=" + std::to_string(movie.year_from) : "") + "&apikey=" + api_key;
 
-        httplib::Client cli("https://www.omdbapi.com");
-        auto res = cli.Get(url);
+        auto res = OmdbGet(url);
 
         if (!res) {
             logError("Connection error in FetchMovieInfo for movie: " + movie.title);
-            connection_error = true;
+            if (update_globals) connection_error = true;
             return false;
         }
 
         if (res->status == 200) {
-            json response = json::parse(res->body);
-            if (response["Response"] == "True") {
-                movie.title = response.value("Title", movie.title);
-                movie.producer = response.value("Director", "Unknown");
-                movie.release_year = response.value("Year", movie.release_year);
-                movie.runtime = response.value("Runtime", "Unknown");
-                movie.rating = response.value("imdbRating", "N/A");
-                movie.votes = response.value("imdbVotes", "N/A");
+            json response = json::parse(res->body, nullptr, false);
+            if (response.is_discarded() || !response.is_object()) {
+                logError("Malformed response for movie: " + movie.title);
+            }
+            else if (response.value("Response", "") == "True") {
+                SetTitle(movie, response.value("Title", movie.title));
+                std::string director = response.value("Director", "N/A");
+                movie.director = director != "N/A" ? Intern(director) : 0;
+                if (response.contains("Year")) ParseYearRange(response.value("Year", ""), movie);
+                movie.runtime_minutes = ParseRuntime(response.value("Runtime", ""));
+                movie.rating_tenths = ParseRating(response.value("imdbRating", ""));
+                movie.votes = ParseVotes(response.value("imdbVotes", ""));
                 movie.id = response.value("imdbID", "");
 
-                // Handle Genre
-                movie.genres.clear();
-                std::string genre_str = response.value("Genre", "");
-                std::istringstream ss(genre_str);
-                std::string genre;
-                while (std::getline(ss, genre, ',')) {
-                    movie.genres.push_back(genre);
-                }
-
-                // Handle Cast
-                movie.cast.clear();
-                std::string cast_str = response.value("Actors", "");
-                std::istringstream cast_ss(cast_str);
-                std::string actor;
-                while (std::getline(cast_ss, actor, ',')) {
-                    movie.cast.push_back(actor);
-                }
+                std::string genres = response.value("Genre", "");
+                movie.genre_count = genres != "N/A" ? InternList(genres, movie.genres, MOVIE_MAX_GENRES) : 0;
+                std::string actors = response.value("Actors", "");
+                movie.cast_count = actors != "N/A" ? InternList(actors, movie.cast, MOVIE_MAX_CAST) : 0;
 
                 // Handle Poster
                 if (response.contains("Poster") && response["Poster"] != "N/A") {
-                    image_url = response["Poster"].get<std::string>();
-                    movie.poster_url = image_url;
+                    movie.poster_url = response["Poster"].get<std::string>();
                 }
                 else {
-                    image_url = "";
                     movie.poster_url = "";
                 }
+                movie.details_loaded = true;
 
-                connection_error = false;
+                if (update_globals) {
+                    image_url = movie.poster_url;
+                    connection_error = false;
+                }
                 return true;
             }
             else {
@@ -279,64 +631,49 @@ bool FetchMovieInfo(Movie& movie) { // info of a spesific movie
         logError("Exception in FetchMovieInfo for movie: " + movie.title + ". Error: " + e.what());
     }
 
-    connection_error = false;
+    if (update_globals) connection_error = false;
     return false;
 }
-void FetchMovieInfoThread(const Movie& movie, int index) { // when removing a movie from watch list, fetches the next one
-    Movie temp_movie = movie;
-    bool fetch_success = FetchMovieInfo(temp_movie);
-    if (fetch_success) {
-        std::lock_guard<std::mutex> lock(mtx);
-        selected_movie = temp_movie;
-        if (index >= 0 && index < watch_list.size()) {
-            watch_list[index] = temp_movie;
-        }
-        // Load the image if it's not already loaded
-        if (!temp_movie.poster_url.empty()) {
-            if (textureMap.find(temp_movie.poster_url) == textureMap.end()) {
-                image_queue.push(temp_movie.poster_url);
-                cv.notify_one();
-            }
-        }
+bool ApplyMovieDetails(MovieHandle handle, unsigned int request, bool success, const Movie& movie) { // render thread, true if the movie is shown
+    bool same_movie = movie.id == handle.key(); // a title lookup can answer with a different movie
+    if (!success) {
+        logError("Failed to fetch movie info for: " + movie.title);
     }
-    else {
-        logError("Failed to fetch movie info for: " + temp_movie.title);
+    else if (same_movie) {
+        movie_store.publish(handle, movie); // every list and the selection see the details from now on
     }
+    if (request != detail_request) return false; // the user selected something else meanwhile
     fetch_in_progress.store(false);
-}
-void FetchMovieDetails(int index) {
-    Movie temp_movie = movie_list[index];
-    bool fetch_success = FetchMovieInfo(temp_movie);
-    if (fetch_success) {
-        bool need_to_fetch_image = false;
-        std::string url_to_fetch;
-
-        {
-            std::lock_guard<std::mutex> lock(mtx);
-
-            temp_movie.in_watch_list = IsInWatchList(temp_movie.id);
-            movie_list[index] = temp_movie;
-
-            if (index == selected_movie_index) {
-                selected_movie = temp_movie;
-
-                if (!temp_movie.poster_url.empty()) {
-                    image_url = temp_movie.poster_url;
-                    if (textureMap.find(image_url) == textureMap.end()) {
-                        need_to_fetch_image = true;
-                        url_to_fetch = image_url;
-                    }
-                }
-            }
-        }
+    if (!success || !same_movie || selected_movie != handle) return false;
 
-        if (need_to_fetch_image) {
-            std::lock_guard<std::mutex> lock(mtx);
-            image_queue.push(url_to_fetch);
-            cv.notify_one();
-        }
+    image_url = movie.poster_url;
+    connection_error = false;
+    return true;
+}
+Task<void> LoadMovieDetails(MovieHandle handle) { // starts on the render thread
+    std::shared_ptr<const Movie> current = handle.get();
+    if (!current) co_return;
+    Movie movie = *current; // filled in privately, the store swaps it in once on the render thread
+    unsigned int request = ++detail_request;
+    fetch_in_progress.store(true);
+    auto started = std::chrono::steady_clock::now();
+
+    co_await ResumeOn{ task_scheduler, Executor::Worker, TaskPriority::High };
+    bool success = FetchMovieInfo(movie, false);
+    co_await ResumeOn{ task_scheduler, Executor::MainThread };
+
+    auto fetched = std::chrono::steady_clock::now();
+    detail_chain_metrics.chains++;
+    detail_chain_metrics.fetch_ms += std::chrono::duration<double, std::milli>(fetched - started).count();
+    if (!ApplyMovieDetails(handle, request, success, movie) || movie.poster_url.empty()) co_return;
+
+    if (co_await WaitForPoster(DetailPosterUrl(movie.poster_url)) == ImageState::Loaded) {
+        detail_chain_metrics.posters++;
+        detail_chain_metrics.poster_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - fetched).count();
     }
-    fetch_in_progress.store(false);
+}
+void RequestMovieDetails(MovieHandle handle) { // render thread, details and poster load without blocking the frame
+    Spawn(LoadMovieDetails(handle));
 }
 
 // Image
@@ -353,70 +690,92 @@ void CleanupOnError(ImageData& imageData) {
         imageData.texture_id = 0;
     }
     if (imageData.data != nullptr) {
-        stbi_image_free(imageData.data);
+        FreeDecodedImage(imageData.data);
         imageData.data = nullptr;
     }
+    PixelArenaFree(imageData.mip_data);
+    imageData.mip_data = nullptr;
+    block_buffers.release(std::move(imageData.compressed));
     imageData.state = ImageState::Error;
 }
-void CreateTexture(const std::string& url) {
+void CreateTexture(const std::string& url, ImageData& imageData) { // render thread, imageData is not published yet so no lock is held across the GL calls
     try {
-        std::lock_guard<std::mutex> lock(mtx);
-        if (textureMap.find(url) != textureMap.end()) {
-            ImageData& imageData = textureMap[url];
+        bool compressed = !imageData.compressed.empty();
+
+        if ((imageData.data == nullptr && !compressed) || imageData.width == 0 || imageData.height == 0 || imageData.channels == 0) {
+            std::cerr << "Invalid image data for " << url << std::endl;
+            CleanupOnError(imageData);
+            return;
+        }
+
+        if (!glfwGetCurrentContext()) {
+            std::cerr << "No OpenGL context current for thread" << std::endl;
+            return;
+        }
 
-            if (imageData.data == nullptr || imageData.width == 0 || imageData.height == 0 || imageData.channels == 0) {
-                std::cerr << "Invalid image data for " << url << std::endl;
+        if (imageData.texture_id == 0 && (imageData.data != nullptr || compressed)) {
+            if (!compressed && !IsValidImageData(imageData, url)) {
+                CleanupOnError(imageData);
+                return;
+            }
+            GLint maxTextureSize;
+            glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+            if (imageData.width > maxTextureSize || imageData.height > maxTextureSize) {
+                std::cerr << "Texture size exceeds maximum allowed size for " << url << std::endl;
+                CleanupOnError(imageData);
+                return;
+            }
+            glGenTextures(1, &imageData.texture_id);
+            if (imageData.texture_id == 0) {
+                std::cerr << "Failed to generate texture for " << url << std::endl;
+                CleanupOnError(imageData);
+                return;
+            }
+            glBindTexture(GL_TEXTURE_2D, imageData.texture_id);
+            GLenum error = glGetError();
+            if (error != GL_NO_ERROR) {
+                std::cerr << "OpenGL error in glBindTexture: " << error << std::endl;
                 CleanupOnError(imageData);
                 return;
             }
 
-            if (!glfwGetCurrentContext()) {
-                std::cerr << "No OpenGL context current for thread" << std::endl;
+            // trilinear filtering lets the same texture serve thumbnails and the detail view
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, imageData.mip_levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, imageData.mip_levels - 1);
+            error = glGetError();
+            if (error != GL_NO_ERROR) {
+                std::cerr << "OpenGL error in glTexParameteri (MIN_FILTER): " << error << std::endl;
+                CleanupOnError(imageData);
                 return;
             }
 
-            if (imageData.texture_id == 0 && imageData.data != nullptr) {
-                if (!IsValidImageData(imageData, url)) {
-                    CleanupOnError(imageData);
-                    return;
-                }
-                GLint maxTextureSize;
-                glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
-                if (imageData.width > maxTextureSize || imageData.height > maxTextureSize) {
-                    std::cerr << "Texture size exceeds maximum allowed size for " << url << std::endl;
-                    CleanupOnError(imageData);
-                    return;
-                }
-                glGenTextures(1, &imageData.texture_id);
-                if (imageData.texture_id == 0) {
-                    std::cerr << "Failed to generate texture for " << url << std::endl;
-                    CleanupOnError(imageData);
-                    return;
-                }
-                glBindTexture(GL_TEXTURE_2D, imageData.texture_id);
-                GLenum error = glGetError();
-                if (error != GL_NO_ERROR) {
-                    std::cerr << "OpenGL error in glBindTexture: " << error << std::endl;
-                    CleanupOnError(imageData);
-                    return;
-                }
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            error = glGetError();
+            if (error != GL_NO_ERROR) {
+                std::cerr << "OpenGL error in glTexParameteri (MAG_FILTER): " << error << std::endl;
+                CleanupOnError(imageData);
+                return;
+            }
 
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                error = glGetError();
-                if (error != GL_NO_ERROR) {
-                    std::cerr << "OpenGL error in glTexParameteri (MIN_FILTER): " << error << std::endl;
-                    CleanupOnError(imageData);
-                    return;
+            if (compressed) {
+                const unsigned char* blocks = imageData.compressed.data();
+                int level_width = imageData.width, level_height = imageData.height;
+                for (int level = 0; level < imageData.mip_levels; ++level) {
+                    std::size_t level_size = Bc1Size(level_width, level_height);
+                    glCompressedTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, level_width, level_height, 0,
+                        (GLsizei)level_size, blocks);
+                    blocks += level_size;
+                    level_width = std::max(1, level_width / 2);
+                    level_height = std::max(1, level_height / 2);
                 }
-
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
                 error = glGetError();
                 if (error != GL_NO_ERROR) {
-                    std::cerr << "OpenGL error in glTexParameteri (MAG_FILTER): " << error << std::endl;
+                    std::cerr << "OpenGL error in glCompressedTexImage2D: " << error << std::endl;
                     CleanupOnError(imageData);
                     return;
                 }
-
+            }
+            else {
                 GLenum internalFormat, format;
                 if (imageData.channels == 1) {
                     internalFormat = GL_RED;
@@ -437,18 +796,30 @@ void CreateTexture(const std::string& url) {
                 }
                 glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, imageData.width, imageData.height, 0,
                     format, GL_UNSIGNED_BYTE, imageData.data);
+                const unsigned char* level_pixels = imageData.mip_data;
+                int level_width = imageData.width, level_height = imageData.height;
+                for (int level = 1; level < imageData.mip_levels; ++level) {
+                    level_width = std::max(1, level_width / 2);
+                    level_height = std::max(1, level_height / 2);
+                    glTexImage2D(GL_TEXTURE_2D, level, internalFormat, level_width, level_height, 0,
+                        format, GL_UNSIGNED_BYTE, level_pixels);
+                    level_pixels += (std::size_t)level_width * level_height * imageData.channels;
+                }
                 error = glGetError();
                 if (error != GL_NO_ERROR) {
                     std::cerr << "OpenGL error in glTexImage2D: " << error << std::endl;
                     CleanupOnError(imageData);
                     return;
                 }
-                imageData.state = ImageState::Loaded;
-
-                glBindTexture(GL_TEXTURE_2D, 0);
-                stbi_image_free(imageData.data);
-                imageData.data = nullptr;
             }
+            imageData.state = ImageState::Loaded;
+
+            glBindTexture(GL_TEXTURE_2D, 0);
+            FreeDecodedImage(imageData.data);
+            imageData.data = nullptr;
+            PixelArenaFree(imageData.mip_data);
+            imageData.mip_data = nullptr;
+            block_buffers.release(std::move(imageData.compressed));
         }
     }
     catch (const std::exception& e) {
@@ -461,56 +832,67 @@ void CreateTexture(const std::string& url) {
 void EnsureImageLoaded(const std::string& url) {
     if (url.empty()) return;
 
-    std::lock_guard<std::mutex> lock(mtx);
-    auto it = textureMap.find(url);
-    if (it == textureMap.end() || it->second.state == ImageState::NotLoaded) {
-        // Image not loaded, start loading
-        textureMap[url] = { nullptr, 0, 0, 0, 0, ImageState::Loading };
-        image_queue.push(url);
-        cv.notify_one();
-    }
+    QueuePosterDownload(url, PosterPriority::Visible);
 }
-void DisplayMoviePoster(const std::string& poster_url, float image_width, float image_height) {
-    if (!poster_url.empty()) {
+void DisplayMoviePoster(const std::string& movie_poster_url, float image_width, float image_height) {
+    if (!movie_poster_url.empty()) {
+        ImVec2 scale = ImGui::GetIO().DisplayFramebufferScale;
+        std::string poster_url = BuildPosterUrl(movie_poster_url, PosterSizeFor(image_width * scale.x, image_height * scale.y));
         EnsureImageLoaded(poster_url);
-        auto it = textureMap.find(poster_url);
-        if (it != textureMap.end()) {
-            switch (it->second.state) {
-            case ImageState::Loaded:
-                if (it->second.texture_id != 0) {
-                    ImGui::Image((void*)(intptr_t)it->second.texture_id, ImVec2(image_width, image_height));
-                }
-                else {
-                    ImGui::Text("Texture not created yet");
-                    CreateTexture(poster_url);
-                }
-                break;
-            case ImageState::Loading:
-                ImGui::Text("Loading image...");
-                break;
-            case ImageState::Error:
-                ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Failed to load image");
-                break;
-            case ImageState::NotLoaded:
-                ImGui::Text("Image not loaded");
-                break;
+        // copy what is needed out of the shard, ImGui is called without the lock
+        std::pair<ImageState, GLuint> image = textures.with(poster_url, [](const ImageData* data) {
+            return data != nullptr ? std::make_pair(data->state, data->texture_id) : std::make_pair(ImageState::NotLoaded, GLuint(0));
+        });
+        switch (image.first) {
+        case ImageState::Loaded:
+            if (image.second != 0) {
+                ImGui::Image((void*)(intptr_t)image.second, ImVec2(image_width, image_height));
             }
-        }
-        else {
-            ImGui::Text("Image not found in texture map");
+            else {
+                ImGui::Text("Texture not created yet");
+            }
+            break;
+        case ImageState::Loading:
+            ImGui::Text("Loading image...");
+            break;
+        case ImageState::Error:
+            ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Failed to load image");
+            break;
+        case ImageState::NotLoaded:
+            ImGui::Text("Image not loaded");
+            break;
         }
     }
     else {
         ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "No poster available for this movie");
     }
 }
+void PrintHttpStatistics() {
+    for (const auto& [origin, stats] : image_clients.statistics()) {
+        unsigned long long reused = stats.requests - stats.new_connections;
+        std::cout << origin << ": " << stats.requests << " requests, " << stats.new_connections << " new connections";
+        if (stats.new_connections > 0) {
+            std::cout << ", avg TTFB new " << stats.ttfb_new_ms / stats.new_connections << " ms";
+        }
+        if (reused > 0) {
+            std::cout << ", avg TTFB reused " << stats.ttfb_reused_ms / reused << " ms";
+        }
+        std::cout << std::endl;
+    }
+}
+void PrintMemoryStatistics() {
+    PixelArena::Statistics arena = PixelArena::instance().statistics();
+    std::cout << "Pixel arena: " << arena.allocations << " allocations, " << arena.heap_allocations
+        << " from the heap, " << arena.cached_bytes / 1024 << " KB cached; body buffer growths: "
+        << body_buffer_growths.load() << ", block buffer growths: " << block_buffer_growths.load() << std::endl;
+}
 GLuint LoadWelcomeImage(const char* filename)
 {
     int width, height, channels;
-    unsigned char* data = stbi_load(filename, &width, &height, &channels, STBI_rgb_alpha);
+    unsigned char* data = DecodeImageFile(filename, &width, &height, &channels, 4);
     if (!data) {
         std::cerr << "Failed to load welcome image: " << filename << std::endl;
-        std::cerr << "STB Error: " << stbi_failure_reason() << std::endl;
+        std::cerr << "STB Error: " << DecodeFailureReason() << std::endl;
         return 0;
     }
 
@@ -520,68 +902,212 @@ GLuint LoadWelcomeImage(const char* filename)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    // Since we're using STBI_rgb_alpha, we always have 4 channels
+    // Since we asked for 4 channels, we always have RGBA
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
 
     glBindTexture(GL_TEXTURE_2D, 0);
-    stbi_image_free(data);
+    FreeDecodedImage(data);
     return texture_id;
 }
-void LoadImageFromUrl(const std::string& url) {
+bool SupportsS3tc() {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+    std::vector<GLint> formats(count > 0 ? count : 0);
+    if (count > 0) {
+        glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+    }
+    return std::find(formats.begin(), formats.end(), GL_COMPRESSED_RGB_S3TC_DXT1_EXT) != formats.end();
+}
+fs::path PosterCachePath(const std::string& url) {
+    // FNV-1a, stable between runs unlike std::hash
+    unsigned long long hash = 14695981039346656037ull;
+    for (unsigned char c : url) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bc1", hash);
+    return fs::path(GetExecutablePath()) / POSTER_CACHE_DIRECTORY / name;
+}
+std::size_t Bc1MipChainSize(int width, int height) {
+    std::size_t size = 0;
+    for (int level = MipLevelCount(width, height); level > 0; --level) {
+        size += Bc1Size(width, height);
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return size;
+}
+bool LoadCompressedPoster(const std::string& url, DecodedImage& image) {
+    std::ifstream file(PosterCachePath(url), std::ios::binary);
+    if (!file.is_open()) return false;
+
+    char magic[4];
+    unsigned int width = 0, height = 0, levels = 0, size = 0;
+    file.read(magic, 4);
+    file.read(reinterpret_cast<char*>(&width), sizeof(width));
+    file.read(reinterpret_cast<char*>(&height), sizeof(height));
+    file.read(reinterpret_cast<char*>(&levels), sizeof(levels));
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!file || memcmp(magic, "BC1M", 4) != 0 || width == 0 || height == 0
+        || levels != (unsigned int)MipLevelCount(width, height) || size != Bc1MipChainSize(width, height)) {
+        return false;
+    }
+    image.compressed = block_buffers.acquire();
+    if (size > image.compressed.capacity()) {
+        block_buffer_growths++;
+    }
+    image.compressed.resize(size);
+    file.read(reinterpret_cast<char*>(image.compressed.data()), size);
+    if (!file) {
+        block_buffers.release(std::move(image.compressed));
+        return false;
+    }
+    image.url = url;
+    image.width = (int)width;
+    image.height = (int)height;
+    image.channels = 3;
+    image.mip_levels = (int)levels;
+
+    // the modification time doubles as the last use for TrimPosterCache
+    std::error_code ec;
+    fs::last_write_time(PosterCachePath(url), fs::file_time_type::clock::now(), ec);
+    return true;
+}
+void TrimPosterCache() { // task pool: at startup and whenever a save pushes the cache past POSTER_CACHE_MAX_BYTES
+    bool expected = false;
+    if (!poster_cache_trimming.compare_exchange_strong(expected, true)) return;
+
+    struct CachedPoster {
+        fs::path path;
+        fs::file_time_type used;
+        unsigned long long size;
+    };
+    std::vector<CachedPoster> posters;
+    unsigned long long total = 0;
+    std::error_code ec;
+    for (fs::directory_iterator it(fs::path(GetExecutablePath()) / POSTER_CACHE_DIRECTORY, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() != ".bc1") continue;
+        std::error_code file_ec;
+        CachedPoster poster{ it->path(), it->last_write_time(file_ec), it->file_size(file_ec) };
+        if (file_ec) continue;
+        total += poster.size;
+        posters.push_back(std::move(poster));
+    }
+
+    // drop down to three quarters of the cap so the next few saves do not trim again
+    if (total > POSTER_CACHE_MAX_BYTES) {
+        std::sort(posters.begin(), posters.end(), [](const CachedPoster& a, const CachedPoster& b) { return a.used < b.used; });
+        for (const CachedPoster& poster : posters) {
+            if (total <= POSTER_CACHE_MAX_BYTES / 4 * 3) break;
+            if (fs::remove(poster.path, ec)) {
+                total -= poster.size;
+            }
+        }
+    }
+    poster_cache_bytes = total;
+    poster_cache_trimming = false;
+}
+void SaveCompressedPoster(const std::string& url, const DecodedImage& image) {
+    fs::path path = PosterCachePath(url);
+    fs::path temp_path = path;
+    temp_path += ".tmp";
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return;
+    unsigned int width = image.width, height = image.height, levels = image.mip_levels, size = (unsigned int)image.compressed.size();
+    file.write("BC1M", 4);
+    file.write(reinterpret_cast<const char*>(&width), sizeof(width));
+    file.write(reinterpret_cast<const char*>(&height), sizeof(height));
+    file.write(reinterpret_cast<const char*>(&levels), sizeof(levels));
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(image.compressed.data()), size);
+    file.close();
+    if (file) {
+        std::error_code size_ec;
+        unsigned long long replaced = fs::file_size(path, size_ec); // saving a poster again overwrites its file
+        if (size_ec) replaced = 0;
+        fs::rename(temp_path, path, ec);
+        if (!ec && (poster_cache_bytes += 20 + size - replaced) > POSTER_CACHE_MAX_BYTES) {
+            task_scheduler.submit([] { TrimPosterCache(); }, TaskPriority::Low);
+        }
+    }
+}
+bool LoadImageFromUrl(const std::string& url, std::vector<unsigned char>& body) { // download stage, runs on the I/O threads
     if (url.empty()) {
         std::cerr << "Empty URL provided to LoadImageFromUrl" << std::endl;
-        return;
+        return false;
     }
 
-    httplib::SSLClient cli("m.media-amazon.com");
-    cli.set_follow_location(true);
-    cli.set_connection_timeout(10);
-    cli.set_read_timeout(10);
-
     httplib::Headers headers = {
         {"User-Agent", "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/91.0.4472.124 Safari/537.36"}
     };
 
-    std::string path = url.substr(url.find("/images"));
-
-    auto res = cli.Get(path, headers);
-    if (res && res->status == 200) {
-        int width, height, channels;
-        unsigned char* data = stbi_load_from_memory(
-            reinterpret_cast<const unsigned char*>(res->body.c_str()),
-            (int)res->body.size(), &width, &height, &channels, 0
-        );
-
-        if (data == nullptr) {
-            std::cerr << "Failed to load image from " << url << ": " << stbi_failure_reason() << std::endl;
-            return;
-        }
-
-
-
-        std::unique_lock<std::mutex> lock(mtx);
-        textureMap[url] = { data, width, height, channels, 0, ImageState::Loaded };
-        glfwPostEmptyEvent();
-
-    }
-    else {
-        std::cerr << "Failed to download image from URL: " << url << ". Status: " << (res ? res->status : 0) << std::endl;
-        std::lock_guard<std::mutex> lock(mtx);
-        textureMap[url] = { nullptr, 0, 0, 0, 0, ImageState::Error };
+    // stream the body straight into the pooled buffer instead of collecting it in res->body
+    body.clear();
+    int status = 0;
+    HttpClientPool::Timings timings;
+    bool downloaded = image_clients.get(url, headers,
+        [&body](const char* data, size_t length) {
+            if (body.size() + length > body.capacity()) {
+                body_buffer_growths++;
+            }
+            body.insert(body.end(), data, data + length);
+            return true;
+        }, status, timings);
+    if (downloaded) {
+        return true;
     }
+    std::cerr << "Failed to download image from URL: " << url << ". Status: " << status << std::endl;
+    RecordPosterFailure(url, status);
+    ImageData failed;
+    failed.state = ImageState::Error;
+    textures.set(url, failed);
+    return false;
+}
+void RecordStage(StageMetrics& metrics, std::chrono::steady_clock::time_point queued, std::chrono::steady_clock::time_point started) {
+    auto now = std::chrono::steady_clock::now();
+    metrics.items++;
+    metrics.wait_microseconds += std::chrono::duration_cast<std::chrono::microseconds>(started - queued).count();
+    metrics.work_microseconds += std::chrono::duration_cast<std::chrono::microseconds>(now - started).count();
 }
-void ImageLoadingThread() {
+void RecordDepth(StageMetrics& metrics, std::size_t depth) {
+    unsigned int current = metrics.max_depth.load();
+    while (depth > current && !metrics.max_depth.compare_exchange_weak(current, (unsigned int)depth)) {}
+}
+void ImageDownloadThread() {
+    std::string url;
+    int priority = 0;
+    std::chrono::steady_clock::time_point queued;
     while (image_thread_running) {
-        std::unique_lock<std::mutex> lock(mtx);
-        if (cv.wait_for(lock, std::chrono::seconds(1), [] { return !image_queue.empty() || !image_thread_running; })) {
+        if (image_queue.pop_for(url, std::chrono::seconds(1), &priority, &queued)) {
             if (!image_thread_running) break;
-            std::string url = image_queue.front();
-            image_queue.pop();
-            lock.unlock();
 
             if (!url.empty() && url != "N/A") {
                 try {
-                    LoadImageFromUrl(url);
+                    // warm start: a poster compressed in an earlier run skips download and decode
+                    DecodedImage cached;
+                    if (use_compressed_textures && LoadCompressedPoster(url, cached)) {
+                        cached.queued = std::chrono::steady_clock::now();
+                        cached.priority = priority;
+                        if (!upload_queue.push(std::move(cached), priority)) break;
+                        RecordDepth(upload_metrics, upload_queue.size());
+                        continue;
+                    }
+
+                    auto started = std::chrono::steady_clock::now();
+                    DownloadedImage image{ url, body_buffers.acquire(), started, priority };
+                    if (LoadImageFromUrl(url, image.body)) {
+                        RecordStage(download_metrics, queued, started);
+                        image.queued = std::chrono::steady_clock::now();
+                        // blocks while the decoders are behind, which in turn stops this thread from downloading more
+                        if (!download_queue.push(std::move(image))) break;
+                        RecordDepth(decode_metrics, download_queue.size());
+                    }
+                    else {
+                        body_buffers.release(std::move(image.body));
+                    }
                 }
                 catch (const std::exception& e) {
                     std::cerr << "Exception in LoadImageFromUrl: " << e.what() << std::endl;
@@ -596,160 +1122,650 @@ void ImageLoadingThread() {
         }
     }
 }
+void ImageDecodeThread() {
+    DownloadedImage image;
+    while (download_queue.pop(image)) {
+        auto started = std::chrono::steady_clock::now();
+        DecodedImage decoded;
+        decoded.url = image.url;
+        decoded.priority = image.priority;
+        // always RGBA so the mip filter can work on whole pixels
+        decoded.data = DecodeImage(image.body.data(), (int)image.body.size(),
+            &decoded.width, &decoded.height, &decoded.channels, 4);
+        decoded.channels = 4;
+        body_buffers.release(std::move(image.body));
+
+        if (decoded.data == nullptr) {
+            std::cerr << "Failed to load image from " << image.url << ": " << DecodeFailureReason() << std::endl;
+            RecordPosterFailure(image.url, 200);
+            ImageData failed;
+            failed.state = ImageState::Error;
+            textures.set(image.url, failed);
+            continue;
+        }
+        decoded.mip_levels = MipLevelCount(decoded.width, decoded.height);
+        decoded.mip_data = static_cast<unsigned char*>(PixelArenaMalloc(std::max<std::size_t>(1, MipChainSize(decoded.width, decoded.height))));
+        BuildMipChain(decoded.data, decoded.width, decoded.height, decoded.mip_data);
+
+        if (use_compressed_textures) {
+            std::size_t compressed_size = Bc1MipChainSize(decoded.width, decoded.height);
+            decoded.compressed = block_buffers.acquire();
+            if (compressed_size > decoded.compressed.capacity()) {
+                block_buffer_growths++;
+            }
+            decoded.compressed.resize(compressed_size);
+            unsigned char* blocks = decoded.compressed.data();
+            const unsigned char* level_pixels = decoded.data;
+            const unsigned char* next_level = decoded.mip_data;
+            int level_width = decoded.width, level_height = decoded.height;
+            for (int level = 0; level < decoded.mip_levels; ++level) {
+                CompressBc1(level_pixels, level_width, level_height, decoded.channels, blocks);
+                blocks += Bc1Size(level_width, level_height);
+                level_width = std::max(1, level_width / 2);
+                level_height = std::max(1, level_height / 2);
+                level_pixels = next_level;
+                next_level += (std::size_t)level_width * level_height * 4;
+            }
+            FreeDecodedImage(decoded.data);
+            decoded.data = nullptr;
+            PixelArenaFree(decoded.mip_data);
+            decoded.mip_data = nullptr;
+            decoded.channels = 3;
+            SaveCompressedPoster(decoded.url, decoded);
+        }
+        RecordPosterSuccess(image.url);
+        RecordStage(decode_metrics, image.queued, started);
+        decoded.queued = std::chrono::steady_clock::now();
+        if (!upload_queue.push(std::move(decoded), decoded.priority)) {
+            FreeDecodedImage(decoded.data);
+            PixelArenaFree(decoded.mip_data);
+            block_buffers.release(std::move(decoded.compressed));
+            break;
+        }
+        RecordDepth(upload_metrics, upload_queue.size());
+        glfwPostEmptyEvent();
+    }
+}
+void UploadDecodedImages() { // upload stage, runs on the render thread once per frame
+    std::vector<DecodedImage> batch; // visible posters first, see PosterPriority
+    upload_queue.drain_into(batch, MAX_UPLOADS_PER_FRAME);
+    for (DecodedImage& decoded : batch) {
+        auto started = std::chrono::steady_clock::now();
+        ImageData image;
+        image.data = decoded.data;
+        image.width = decoded.width;
+        image.height = decoded.height;
+        image.channels = decoded.channels;
+        image.state = ImageState::Loaded;
+        image.compressed = std::move(decoded.compressed);
+        image.mip_data = decoded.mip_data;
+        image.mip_levels = decoded.mip_levels;
+        CreateTexture(decoded.url, image);
+        if (image.texture_id == 0) {
+            CleanupOnError(image);
+        }
+        // only the texture is published, the pixels were freed by CreateTexture
+        ImageData uploaded;
+        uploaded.width = image.width;
+        uploaded.height = image.height;
+        uploaded.channels = image.channels;
+        uploaded.texture_id = image.texture_id;
+        uploaded.state = image.state;
+        textures.set(decoded.url, uploaded);
+        RecordStage(upload_metrics, decoded.queued, started);
+    }
+}
+void PrintStageStatistics(const char* name, const StageMetrics& metrics) {
+    unsigned long long items = metrics.items.load();
+    if (items == 0) return;
+    std::cout << name << ": " << items << " images, avg wait " << metrics.wait_microseconds.load() / items / 1000.0
+        << " ms, avg work " << metrics.work_microseconds.load() / items / 1000.0
+        << " ms, max queue depth " << metrics.max_depth.load() << std::endl;
+}
+void PrintLockStatistics(const char* name, const InstrumentedMutex::Statistics& stats) {
+    if (stats.acquisitions == 0) return;
+    std::cout << name << " lock: " << stats.acquisitions << " acquisitions, " << stats.contended << " contended ("
+        << stats.wait_ms << " ms waited), avg hold " << stats.hold_ms * 1000.0 / stats.acquisitions
+        << " us, max hold " << stats.max_hold_ms << " ms" << std::endl;
+}
+void PrintContentionStatistics() {
+    PrintLockStatistics("Texture map", textures.lock_statistics());
+    PrintLockStatistics("Failed poster urls", failed_poster_urls_mtx.statistics());
+    PrintLockStatistics("Search", search_mtx.statistics());
+}
+void PrintDetailChainStatistics() {
+    const DetailChainMetrics& metrics = detail_chain_metrics;
+    if (metrics.chains == 0) return;
+    std::cout << "Details: " << metrics.chains << " fetches, avg " << metrics.fetch_ms / metrics.chains << " ms to details";
+    if (metrics.posters > 0) {
+        std::cout << ", avg " << metrics.poster_ms / metrics.posters << " ms more until the poster was on screen (" << metrics.posters << " posters)";
+    }
+    std::cout << std::endl;
+}
+void PrintSchedulerStatistics() {
+    TaskScheduler::Statistics stats = task_scheduler.statistics();
+    std::cout << "Task pool: " << task_scheduler.worker_count() << " workers, " << stats.executed << " tasks ("
+        << stats.stolen << " stolen), " << stats.main_thread_tasks << " main thread completions" << std::endl;
+}
+void PrintPipelineStatistics() {
+    PrintStageStatistics("Download", download_metrics);
+    std::string decode_name = std::string("Decode (") + DecodePathName(ActiveDecodePath()) + " JPEG kernels)";
+    PrintStageStatistics(decode_name.c_str(), decode_metrics);
+    PrintStageStatistics("Upload", upload_metrics);
+    std::cout << "Backpressure: download queue full " << download_queue.backpressure_waits()
+        << " times" << std::endl;
+    std::cout << "Upload queue: max depth " << upload_queue.max_depth((int)PosterPriority::Visible) << " visible, "
+        << upload_queue.max_depth((int)PosterPriority::Prefetch) << " prefetch, " << upload_queue.aged_pops() << " aged prefetch pops" << std::endl;
+}
+void PrintStringPoolStatistics() {
+    StringPool::Statistics stats = StringPool::instance().statistics();
+    std::cout << "String pool: " << stats.strings << " strings, " << stats.bytes << " bytes, "
+        << stats.lookups << " lookups" << std::endl;
+}
+void PrintUserStoreStatistics() {
+    std::lock_guard<std::mutex> lock(user_store_mtx);
+    KvStore::Statistics stats = user_store.statistics();
+    std::cout << "User store: " << stats.keys << " keys in " << stats.log_records << " records, " << stats.lookups << " lookups, "
+        << stats.scans << " scans, " << stats.puts << " puts, " << stats.erases << " erases, " << stats.compactions << " compactions, "
+        << stats.log.bytes << " bytes appended, " << stats.log.dropped << " torn tails cut" << std::endl;
+}
+void PrintMovieStoreStatistics() {
+    RecordStore<Movie>::Statistics stats = movie_store.statistics();
+    std::cout << "Movie store: " << stats.records << " records, " << stats.inserts << " inserts, "
+        << stats.updates << " updates, " << stats.released << " released" << std::endl;
+}
 
 
 // Handle Watch list
-void SaveWatchList() {
-    if (current_user.empty()) return;
-    std::string exePath = GetExecutablePath();
-    std::string userDirPath = exePath + "/" + USER_DIRECTORY;
-    fs::path user_file = fs::path(userDirPath) / (current_user + ".txt");
-    std::ofstream file(user_file);
-    if (file.is_open()) {
-        for (const auto& movie : watch_list) {
-            file << movie.id << "|" << movie.title << "|" << movie.release_year << "\n";
+// user_store keys, ordered so that one user's list is a single range scan in list order:
+//   user/<name>                      ""
+//   watch/<name>/<position, 16 hex>  id
+//   movie/<id>                       "year|poster url|title", what the list shows before the warm up
+//   ref/<id>/<name>                  "", that user's list holds the movie; movie/<id> goes with the last one
+//   meta/migration                   "started" or "done", see OpenUserStore
+//   meta/migrated/<name>             "", that user's old files are in the store
+//   meta/refs                        "", every watch list entry has its ref/ key
+// Names and ids go through KeyPart, so "watch/<name>/" never is the prefix of another user's keys.
+std::string KeyPart(const std::string& text) { // '%', '/' and control characters as %XX
+    std::string part;
+    for (unsigned char c : text) {
+        if (c == '%' || c == '/' || c < 0x20 || c == 0x7F) {
+            char escaped[4];
+            std::snprintf(escaped, sizeof(escaped), "%%%02X", c);
+            part += escaped;
+        }
+        else {
+            part += (char)c;
         }
-        file.close();
     }
+    return part;
 }
-void AddToWatchList(const Movie& movie) {
-    if (watch_list_titles.find(movie.id) == watch_list_titles.end()) {
-        Movie watch_list_movie = movie;
-        watch_list_movie.in_watch_list = true;
-        watch_list.push_back(watch_list_movie);
-        watch_list_titles.insert(movie.id);
-        if (!current_user.empty()) {
-            SaveWatchList();
+std::string UserKey(const std::string& user) {
+    return "user/" + KeyPart(user);
+}
+std::string WatchListPrefix(const std::string& user) {
+    return "watch/" + KeyPart(user) + "/";
+}
+std::string WatchListKey(const std::string& user, std::uint64_t position) {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)position);
+    return WatchListPrefix(user) + hex;
+}
+std::string MovieKey(const std::string& id) {
+    return "movie/" + KeyPart(id);
+}
+std::string MovieRefPrefix(const std::string& id) {
+    return "ref/" + KeyPart(id) + "/";
+}
+std::string MovieRefKey(const std::string& id, const std::string& user) {
+    return MovieRefPrefix(id) + KeyPart(user);
+}
+void BackfillMovieRefs() { // user_store_mtx held: stores written before the ref/ keys get one per watch list entry
+    std::vector<std::pair<std::string, std::string>> refs; // movie, escaped user
+    user_store.scan("watch/", [&](const std::string& key, const std::string& id) {
+        std::size_t user_end = key.find('/', 6);
+        if (user_end != std::string::npos) refs.emplace_back(id, key.substr(6, user_end - 6));
+    });
+    bool written = true;
+    for (const auto& [id, user] : refs) {
+        written = written && user_store.put(MovieRefPrefix(id) + user, "");
+    }
+    if (written) user_store.put("meta/refs", "");
+}
+std::string MovieValue(const Movie& movie) {
+    return YearText(movie) + "|" + movie.poster_url + "|" + movie.title;
+}
+bool ParseMovieValue(const std::string& value, Movie& movie) {
+    std::size_t year_end = value.find('|');
+    std::size_t poster_end = year_end == std::string::npos ? std::string::npos : value.find('|', year_end + 1);
+    if (poster_end == std::string::npos) return false;
+    ParseYearRange(value.substr(0, year_end), movie);
+    movie.poster_url = value.substr(year_end + 1, poster_end - year_end - 1);
+    SetTitle(movie, value.substr(poster_end + 1));
+    return true;
+}
+bool ParseWatchListEntry(const std::string& line, Movie& movie) { // "id|title|year", the lines of the old users/<name>.txt
+    std::istringstream iss(line);
+    std::string id, title, year;
+    if (!(std::getline(iss, id, '|') && std::getline(iss, title, '|') && std::getline(iss, year))) return false;
+    movie.id = id;
+    SetTitle(movie, title);
+    ParseYearRange(year, movie);
+    return true;
+}
+bool MigrateUserFiles(const fs::path& user_dir) { // user_store_mtx held: imports users/<name>.txt and the .log journal on top of it, true once every file is in
+    std::error_code ec;
+    bool complete = true;
+    fs::directory_iterator entries(user_dir, ec);
+    if (ec) return false;
+    for (const auto& entry : entries) {
+        if (entry.path().extension() != ".txt") continue;
+        std::string user = entry.path().stem().string();
+        std::string migrated_key = "meta/migrated/" + KeyPart(user);
+        if (user_store.contains(migrated_key)) continue; // imported by an earlier, interrupted run
+
+        std::vector<Movie> movies;
+        std::set<std::string> ids;
+        std::ifstream file(entry.path());
+        if (!file.is_open()) {
+            std::cerr << "Unable to read " << entry.path() << ", it is imported on the next start" << std::endl;
+            complete = false;
+            continue;
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            Movie movie;
+            if (ParseWatchListEntry(line, movie) && ids.insert(movie.id).second) movies.push_back(std::move(movie));
+        }
+        AppendLog journal;
+        journal.open(fs::path(user_dir) / (user + ".log"));
+        journal.replay([&](const std::string& record) {
+            Movie movie;
+            if (record.rfind("A|", 0) == 0 && ParseWatchListEntry(record.substr(2), movie)) {
+                if (ids.insert(movie.id).second) movies.push_back(std::move(movie));
+            }
+            else if (record.rfind("R|", 0) == 0 && ids.erase(record.substr(2)) > 0) {
+                std::string id = record.substr(2);
+                movies.erase(std::find_if(movies.begin(), movies.end(), [&id](const Movie& movie) { return movie.id == id; }));
+            }
+        });
+
+        bool written = user_store.put(UserKey(user), "");
+        for (std::size_t position = 0; written && position < movies.size(); ++position) {
+            written = user_store.put(MovieKey(movies[position].id), MovieValue(movies[position]))
+                && user_store.put(WatchListKey(user, position), movies[position].id)
+                && user_store.put(MovieRefKey(movies[position].id, user), "");
+        }
+        if (!written || !user_store.put(migrated_key, "")) {
+            std::cerr << "Unable to import " << entry.path() << " into the user store, it is retried on the next start" << std::endl;
+            complete = false;
+        }
+    }
+    return complete;
+}
+void OpenUserStore() { // startup
+    fs::path user_dir = fs::path(GetExecutablePath() + "/" + USER_DIRECTORY);
+    std::error_code ec;
+    fs::create_directories(user_dir, ec);
+    std::lock_guard<std::mutex> lock(user_store_mtx);
+    std::string migration;
+    if (!user_store.open(user_dir / USER_STORE_FILE)) {
+        user_store.put("meta/migration", "started"); // first start with the store
+    }
+    else if (!user_store.get("meta/migration", migration)) {
+        user_store.put("meta/migration", "done"); // written by a version that migrated in one go before creating the file
+    }
+    // the per-user files are left as they were; completion is only recorded once every one of them is in
+    if (user_store.get("meta/migration", migration) && migration != "done" && MigrateUserFiles(user_dir)) {
+        user_store.put("meta/migration", "done");
+    }
+    if (!user_store.contains("meta/refs")) {
+        BackfillMovieRefs();
+    }
+}
+void CompactUserStore() { // task pool: user_store_mtx is only held to freeze the entries and to swap the files
+    KvStore::Compaction compaction;
+    {
+        std::lock_guard<std::mutex> lock(user_store_mtx);
+        if (!user_store.needs_compaction()) return;
+        compaction = user_store.begin_compaction();
+    }
+    bool written = KvStore::write_compaction(compaction);
+    std::lock_guard<std::mutex> lock(user_store_mtx);
+    if (!user_store.finish_compaction(compaction, written)) {
+        std::cerr << "Unable to compact the user store, the old file is kept" << std::endl;
+    }
+}
+void WriteUserStoreChanges() { // any thread: applies every queued write in order
+    std::lock_guard<std::mutex> lock(user_store_mtx);
+    std::vector<UserStoreWrite> writes;
+    {
+        std::lock_guard<std::mutex> writes_lock(user_store_writes_mtx);
+        writes.swap(user_store_writes);
+    }
+    for (const UserStoreWrite& write : writes) {
+        bool written = write.erase ? user_store.erase(write.key) : user_store.put(write.key, write.value);
+        if (!written) {
+            std::cerr << "Unable to write " << write.key << " to the user store" << std::endl;
         }
-        if (selected_movie.id == movie.id) {
-            selected_movie.in_watch_list = true;
+        else if (!write.release_movie.empty() && !user_store.contains_prefix(MovieRefPrefix(write.release_movie))) {
+            user_store.erase(MovieKey(write.release_movie));
         }
     }
+    if (user_store.needs_compaction()) {
+        task_scheduler.submit([] { CompactUserStore(); }, TaskPriority::Low);
+    }
+}
+Task<void> SaveWatchListAsync() {
+    co_await ResumeOn{ task_scheduler, Executor::Worker, TaskPriority::Low };
+    WriteUserStoreChanges();
+}
+void SaveWatchList(std::vector<UserStoreWrite> writes) { // queues one change for the task pool, the UI does not wait for the disk
+    if (current_user.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(user_store_writes_mtx);
+        for (auto& write : writes) user_store_writes.push_back(std::move(write));
+    }
+    Spawn(SaveWatchListAsync());
+}
+void FlushWatchList() { // logout and shutdown: queued saves may be dropped with the task pool, write them now
+    WriteUserStoreChanges();
+}
+void AddToWatchList(MovieHandle movie) {
+    if (movie && watch_list_titles.find(movie.key()) == watch_list_titles.end()) {
+        watch_list.update([&](MovieRows& movies) { movies.push_back(movie); });
+        std::uint64_t position = watch_list_next_position++;
+        watch_list_titles.emplace(movie.key(), position);
+        std::shared_ptr<const Movie> record = movie.get();
+        SaveWatchList({ { MovieKey(record->id), MovieValue(*record) }, { WatchListKey(current_user, position), record->id },
+            { MovieRefKey(record->id, current_user), "" } });
+    }
 }
 std::pair<bool, int> RemoveFromWatchList(const std::string& id) {
     if (!IsInWatchList(id)) {
         return { false, -1 };  // The movie is not in the watch list, so we can't remove it
     }
 
-    auto it = std::find_if(watch_list.begin(), watch_list.end(),
-        [&id](const Movie& movie) { return movie.id == id; });
-
-    if (it != watch_list.end()) {
-        std::size_t removed_index = static_cast<std::size_t>(std::distance(watch_list.begin(), it));
-        watch_list.erase(it);
-        watch_list_titles.erase(id);
-
-        // Update the in_watch_list status for all movies in movie_list
-        for (auto& movie : movie_list) {
-            if (movie.id == id) {
-                movie.in_watch_list = false;
-            }
-        }
-
-        if (!current_user.empty()) {
-            SaveWatchList();
-        }
+    std::size_t remaining = 0;
+    int removed_index = watch_list.update([&](MovieRows& movies) {
+        auto it = std::find_if(movies.begin(), movies.end(),
+            [&id](const MovieHandle& movie) { return movie.key() == id; });
+        if (it == movies.end()) return -1;
+        int index = static_cast<int>(std::distance(movies.begin(), it));
+        movies.erase(it);
+        remaining = movies.size();
+        return index;
+    });
+
+    if (removed_index != -1) {
+        auto entry = watch_list_titles.find(id);
+        SaveWatchList({ { WatchListKey(current_user, entry->second), "", true }, { MovieRefKey(id, current_user), "", true, id } });
+        watch_list_titles.erase(entry);
 
         // Determine the new selected index
-        std::size_t new_index = removed_index;
-        if (new_index >= watch_list.size()) {
-            new_index = watch_list.size() - 1;
+        int new_index = removed_index;
+        if (new_index >= (int)remaining) {
+            new_index = (int)remaining - 1;
         }
 
         return { true, new_index };
     }
     return { false, -1 };
 }
-void LoadWatchList(const std::string& username) {
-    watch_list.clear();
+void LoadWatchList(const std::string& username) { // user_store_mtx held
+    MovieRows movies;
     watch_list_titles.clear();
-    std::string exePath = GetExecutablePath();
-    std::string userDirPath = exePath + "/" + USER_DIRECTORY;
-    fs::path user_file = fs::path(userDirPath) / (username + ".txt");
-    std::ifstream file(user_file);
-    if (file.is_open()) {
-        std::string line;
-        while (std::getline(file, line)) {
-            std::istringstream iss(line);
-            std::string id, title, year;
-            if (std::getline(iss, id, '|') && std::getline(iss, title, '|') && std::getline(iss, year)) {
-                Movie movie;
-                movie.id = id;
-                movie.title = title;
-                movie.release_year = year;
-                movie.in_watch_list = true;
-                watch_list.push_back(movie);
-                watch_list_titles.insert(id);
-            }
+    watch_list_next_position = 0;
+    std::string prefix = WatchListPrefix(username);
+    user_store.scan(prefix, [&](const std::string& key, const std::string& id) {
+        std::uint64_t position = std::strtoull(key.c_str() + prefix.size(), nullptr, 16);
+        watch_list_next_position = position + 1;
+        Movie movie;
+        std::string value;
+        if (!user_store.get(MovieKey(id), value) || !ParseMovieValue(value, movie)) return;
+        movie.id = id;
+        if (watch_list_titles.emplace(id, position).second) {
+            movies.push_back(movie_store.insert(id, std::move(movie))); // keeps the details if this movie was seen before
         }
-        file.close();
+    });
+    watch_list.publish(std::move(movies));
+}
+
+// Watch list warm up: fetch details and posters for the whole list in the background after login
+void ApplyWarmedMovie(MovieHandle handle, const Movie& movie, bool success, unsigned int generation) { // render thread
+    if (watch_list_warm_generation.load() != generation) return; // logged out or in again meanwhile
+    watch_list_warm_done++;
+    if (!success || movie.id != handle.key()) return;
+    movie_store.publish(handle, movie);
+    if (selected_movie == handle) {
+        image_url = movie.poster_url;
+    }
+}
+void WarmWatchListTask(std::shared_ptr<const MovieRows> movies, std::shared_ptr<std::atomic<int>> next, unsigned int generation) { // task pool
+    for (int i = (*next)++; i < (int)movies->size(); i = (*next)++) {
+        if (watch_list_warm_generation.load() != generation) return;
+
+        MovieHandle handle = (*movies)[i];
+        Movie movie = *handle.get();
+        bool success = FetchMovieInfo(movie, false);
+        if (success && !movie.poster_url.empty()) {
+            QueuePosterDownload(BuildPosterUrl(movie.poster_url, PosterSize::Thumbnail), PosterPriority::Prefetch, true);
+            QueuePosterDownload(DetailPosterUrl(movie.poster_url), PosterPriority::Prefetch, true);
+        }
+        task_scheduler.post_to_main([handle, movie, success, generation]() { ApplyWarmedMovie(handle, movie, success, generation); });
+    }
+}
+void StopWatchListWarmup() {
+    watch_list_warm_generation++;
+    watch_list_warm_total = 0;
+    watch_list_warm_done = 0;
+}
+void StartWatchListWarmup() {
+    StopWatchListWarmup();
+    std::shared_ptr<const MovieRows> movies = watch_list.load(); // the tasks keep this version alive
+    if (movies->empty()) return;
+
+    unsigned int generation = watch_list_warm_generation.load();
+    watch_list_warm_total = (int)movies->size();
+    auto next = std::make_shared<std::atomic<int>>(0);
+    for (int i = 0; i < WATCH_LIST_WARM_TASKS; ++i) {
+        task_scheduler.submit([movies, next, generation]() { WarmWatchListTask(movies, next, generation); }, TaskPriority::Low);
     }
 }
+bool IsWatchListWarming() {
+    return watch_list_warm_total.load() > 0 && watch_list_warm_done.load() < watch_list_warm_total.load();
+}
 
 // User interface
+void SetupMovieTableColumns() { // the search results and the watch list share their columns
+    ImGui::TableSetupColumn("Title", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_WidthStretch, 0.4f, (ImGuiID)SortColumn::Title);
+    ImGui::TableSetupColumn("Year", ImGuiTableColumnFlags_WidthStretch, 0.15f, (ImGuiID)SortColumn::Year);
+    ImGui::TableSetupColumn("Rating", ImGuiTableColumnFlags_PreferSortDescending | ImGuiTableColumnFlags_WidthStretch, 0.12f, (ImGuiID)SortColumn::Rating);
+    ImGui::TableSetupColumn("Votes", ImGuiTableColumnFlags_PreferSortDescending | ImGuiTableColumnFlags_WidthStretch, 0.18f, (ImGuiID)SortColumn::Votes);
+    ImGui::TableSetupColumn("Runtime", ImGuiTableColumnFlags_WidthStretch, 0.15f, (ImGuiID)SortColumn::Runtime);
+    ImGui::TableHeadersRow();
+}
+void MovieTableCells(const Movie& movie) { // every column after the title, blank until the details are known
+    ImGui::TableSetColumnIndex(1);
+    ImGui::Text("%s", YearText(movie).c_str());
+    ImGui::TableSetColumnIndex(2);
+    if (movie.rating_tenths != 0) ImGui::Text("%.1f", movie.rating_tenths / 10.0f);
+    ImGui::TableSetColumnIndex(3);
+    if (movie.votes != 0) ImGui::Text("%s", VotesText(movie.votes).c_str());
+    ImGui::TableSetColumnIndex(4);
+    if (movie.runtime_minutes != 0) ImGui::Text("%d min", movie.runtime_minutes);
+}
 bool UserLogin(const std::string& username) {
-    std::string exePath = GetExecutablePath();
-    std::string userDirPath = exePath + "/" + USER_DIRECTORY;
-
-    if (!fs::exists(userDirPath)) {
-        fs::create_directory(userDirPath);
-    }
-
-    fs::path user_file = fs::path(userDirPath) / (username + ".txt");
-    if (fs::exists(user_file)) {
+    std::lock_guard<std::mutex> lock(user_store_mtx);
+    if (user_store.contains(UserKey(username))) {
         // User exists, load their watch list
         current_user = username;
         LoadWatchList(username);
+        StartWatchListWarmup();
         return true;
     }
-    else {
-        // New user, create file
-        std::ofstream file(user_file);
-        if (file.is_open()) {
-            file.close();
-            current_user = username;
-            watch_list.clear();
-            watch_list_titles.clear();
-            return true;
-        }
+    else if (user_store.put(UserKey(username), "")) {
+        // New user
+        current_user = username;
+        StopWatchListWarmup();
+        watch_list.publish({});
+        watch_list_titles.clear();
+        watch_list_next_position = 0;
+        return true;
     }
     return false;
 }
 void Logout() {
+    StopWatchListWarmup();
+    FlushWatchList();
     current_user = "";
-    watch_list.clear();
+    watch_list.publish({});
     watch_list_titles.clear();
     ResetApplication();
 }
 
 // Sort Functions
-bool compareMoviesByTitle(const Movie& a, const Movie& b, bool ascending) {
-    return ascending ? (a.title < b.title) : (a.title > b.title);
+// the order every permutation of spec follows: key by key, ties keep the list order
+bool RowLess(const ListOrder& cache, const SortSpec& spec, std::uint32_t a, std::uint32_t b) {
+    for (const SortKey& key : spec) {
+        int c = CompareMovies(*cache.records[a], *cache.records[b], key.column);
+        if (c != 0) return key.ascending ? c < 0 : c > 0;
+    }
+    return a < b;
+}
+std::uint64_t EncodeSortSpec(const SortSpec& spec) { // 4 bits per key after a 4 bit count
+    std::uint64_t code = spec.size();
+    for (std::size_t i = 0; i < spec.size(); ++i) {
+        code |= (std::uint64_t)((int)spec[i].column | (spec[i].ascending ? 0 : 8)) << (4 * (i + 1));
+    }
+    return code;
 }
-bool compareMoviesByYear(const Movie& a, const Movie& b, bool ascending) {
-    return ascending ? (a.release_year < b.release_year) : (a.release_year > b.release_year);
+SortSpec DecodeSortSpec(std::uint64_t code) {
+    SortSpec spec(code & 0xF);
+    for (std::size_t i = 0; i < spec.size(); ++i) {
+        int bits = (int)(code >> (4 * (i + 1))) & 0xF;
+        spec[i] = { (SortColumn)(bits & 7), (bits & 8) == 0 };
+    }
+    return spec;
 }
-void sortWatchList() {
-    std::sort(watch_list.begin(), watch_list.end(),
-        [](const Movie& a, const Movie& b) {
-            if (sort_watch_list_by_year) {
-                return compareMoviesByYear(a, b, sort_watch_list_ascending);
-            }
-            else {
-                return compareMoviesByTitle(a, b, sort_watch_list_ascending);
-            }
-        });
+void BuildSortOrder(const ListOrder& cache, const SortSpec& spec, SortedBlockList<std::uint32_t>& sorted) {
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::uint32_t> order(cache.records.size());
+    std::iota(order.begin(), order.end(), 0u);
+    for (auto key = spec.rbegin(); key != spec.rend(); ++key) { // least significant first, every pass is stable
+        SortRowsBy(cache.records, *key, order);
+    }
+    sorted.assign(order);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    sort_metrics.permutations++;
+    sort_metrics.rows += cache.records.size();
+    sort_metrics.total_ms += ms;
+    sort_metrics.max_ms = std::max(sort_metrics.max_ms, ms);
 }
-void sortMovieList() {
-    std::sort(movie_list.begin(), movie_list.end(),
-        [](const Movie& a, const Movie& b) {
-            if (sort_movie_list_by_year) {
-                return compareMoviesByYear(a, b, sort_movie_list_ascending);
-            }
-            else {
-                return compareMoviesByTitle(a, b, sort_movie_list_ascending);
+void ResetListOrder(ListOrder& cache, const std::shared_ptr<const MovieRows>& rows, unsigned long long store_version) {
+    cache.rows = rows;
+    cache.store_version = store_version;
+    cache.records.resize(rows->size());
+    for (std::size_t i = 0; i < rows->size(); ++i) {
+        cache.records[i] = (*rows)[i].get();
+    }
+    cache.orders.clear();
+}
+// moves rows whose records changed to their new place in every cached permutation: a binary search
+// per row instead of a full sort, so details arriving for a large list keep it sorted cheaply
+void RepositionRows(ListOrder& cache, const std::vector<std::uint32_t>& rows) {
+    std::vector<char> moved(cache.records.size(), 0);
+    for (std::uint32_t row : rows) {
+        moved[row] = 1;
+    }
+    for (auto& [code, order] : cache.orders) {
+        SortSpec spec = DecodeSortSpec(code);
+        order.erase_if([&](std::uint32_t row) { return moved[row] != 0; });
+        for (std::uint32_t row : rows) {
+            order.insert(row, [&](std::uint32_t a, std::uint32_t b) { return RowLess(cache, spec, a, b); });
+        }
+    }
+    sort_metrics.repositioned += rows.size() * cache.orders.size();
+}
+// rows version grew by appending (search results streaming in): sorts the new rows into every
+// cached permutation instead of rebuilding them, the rows already shown keep their indices
+void InsertAppendedRows(ListOrder& cache, const std::shared_ptr<const MovieRows>& rows) {
+    std::size_t first = cache.records.size();
+    cache.rows = rows;
+    for (std::size_t row = first; row < rows->size(); ++row) {
+        cache.records.push_back((*rows)[row].get());
+    }
+    for (auto& [code, order] : cache.orders) {
+        SortSpec spec = DecodeSortSpec(code);
+        for (std::size_t row = first; row < rows->size(); ++row) {
+            order.insert((std::uint32_t)row, [&](std::uint32_t a, std::uint32_t b) { return RowLess(cache, spec, a, b); });
+        }
+    }
+    sort_metrics.inserted += (rows->size() - first) * cache.orders.size();
+}
+bool IsAppendOf(const MovieRows& rows, const MovieRows& previous) {
+    return rows.size() >= previous.size() && std::equal(previous.begin(), previous.end(), rows.begin());
+}
+// rows in the order spec asks for; a permutation is built once per spec and list version and then
+// kept up to date as records change
+SortedView SortedOrder(ListOrder& cache, const std::shared_ptr<const MovieRows>& rows, const SortSpec& spec) { // render thread
+    unsigned long long store_version = movie_store.version();
+    if (cache.rows != rows) {
+        // a batch larger than what is already sorted is cheaper to sort from scratch
+        if (cache.rows && IsAppendOf(*rows, *cache.rows) && rows->size() - cache.rows->size() <= cache.rows->size()) {
+            InsertAppendedRows(cache, rows);
+        }
+        else {
+            ResetListOrder(cache, rows, store_version);
+        }
+    }
+    if (cache.store_version != store_version) {
+        std::vector<MovieHandle> changed;
+        if (!movie_store.changed_since(cache.store_version, changed) || changed.size() > LIST_ORDER_MAX_REPOSITION) {
+            ResetListOrder(cache, rows, store_version);
+        }
+        else {
+            std::vector<std::uint32_t> moved;
+            for (std::uint32_t row = 0; row < rows->size(); ++row) {
+                if (std::find(changed.begin(), changed.end(), (*rows)[row]) != changed.end()) {
+                    cache.records[row] = (*rows)[row].get();
+                    moved.push_back(row);
+                }
             }
-        });
+            cache.store_version = store_version;
+            if (!moved.empty()) RepositionRows(cache, moved);
+        }
+    }
+
+    // a descending column gets its own permutation: walking the ascending one backwards would also
+    // reverse the rows that tie, and ties keep the list order in both directions
+    auto [it, inserted] = cache.orders.try_emplace(EncodeSortSpec(spec));
+    if (inserted) {
+        BuildSortOrder(cache, spec, it->second);
+    }
+    return { &it->second };
+}
+int DisplayedRow(const SortedView& view, int position) { // row index shown at position
+    return (int)(*view.order)[position];
+}
+int DisplayPosition(const SortedView& view, int row) { // -1 when row is not shown
+    std::size_t index = view.order->find((std::uint32_t)row);
+    if (index == view.order->size()) return -1;
+    return (int)index;
+}
+SortSpec SortSpecFromTable(const ImGuiTableSortSpecs* specs) {
+    SortSpec spec;
+    for (int i = 0; i < specs->SpecsCount; ++i) {
+        spec.push_back({ (SortColumn)specs->Specs[i].ColumnUserID, specs->Specs[i].SortDirection == ImGuiSortDirection_Ascending });
+    }
+    return spec;
+}
+void PrintSortStatistics() {
+    std::cout << "Sort: " << sort_metrics.permutations << " permutations built over " << sort_metrics.rows << " rows";
+    if (sort_metrics.permutations > 0) {
+        std::cout << ", " << sort_metrics.total_ms / sort_metrics.permutations << " ms avg, " << sort_metrics.max_ms << " ms max";
+    }
+    std::cout << ", " << sort_metrics.repositioned << " rows repositioned, " << sort_metrics.inserted << " rows inserted" << std::endl;
 }
 
 // handle api_key
@@ -828,12 +1844,27 @@ int main() {
         return -1;
     }
 
-    // Start the image loading thread
-    std::thread image_thread(ImageLoadingThread);
+    use_compressed_textures = compress_poster_textures && SupportsS3tc();
+    LoadFailedPosterUrls();
+    OpenUserStore();
+
+    // Start the image pipeline: downloads on an I/O pool, decoding on one thread per core
+    std::vector<std::thread> image_threads;
+    for (int i = 0; i < IMAGE_IO_THREADS; ++i) {
+        image_threads.emplace_back(ImageDownloadThread);
+    }
+    unsigned int decode_thread_count = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int i = 0; i < decode_thread_count; ++i) {
+        image_threads.emplace_back(ImageDecodeThread);
+    }
+
+    // Searches, detail fetches and the watch list warm up share one task pool
+    task_scheduler.start(std::max(4u, std::thread::hardware_concurrency()));
+    if (use_compressed_textures) {
+        task_scheduler.submit([] { TrimPosterCache(); }, TaskPriority::Low);
+    }
 
     // Variables for ImGui input
-    std::thread fetch_thread;// for single movie details
-    std::thread fetcher_thread;// for movie list 
     std::string message;
 
     while (!glfwWindowShouldClose(window)) {
@@ -847,6 +1878,9 @@ int main() {
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
+        UploadDecodedImages();
+        task_scheduler.run_main_thread_tasks();
+        detail_poster_size.store(PosterSizeFor(DETAIL_POSTER_WIDTH * io.DisplayFramebufferScale.x, DETAIL_POSTER_HEIGHT * io.DisplayFramebufferScale.y));
 
         // Create main ImGui window
         ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
@@ -998,7 +2032,8 @@ int main() {
         }
 
         // Display movie details
-        if (selected_movie_index != -1) {
+        if (selected_movie_index != -1 && selected_movie) {
+            std::shared_ptr<const Movie> details = selected_movie.get(); // one version for the whole frame
             ImGui::BeginChild("MovieDetailsLayout", ImVec2(0, -1), false, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize);
 
             // Movie Information
@@ -1006,22 +2041,28 @@ int main() {
                 ImGui::Text("Fetching movie details...");
             }
             else {
-                ImGui::Text("Title: %s", selected_movie.title.c_str());
-                ImGui::Text("Year: %s", selected_movie.release_year.c_str());
-                ImGui::Text("Director: %s", selected_movie.producer.c_str());
-                ImGui::Text("Runtime: %s", selected_movie.runtime.c_str());
-                ImGui::Text("IMDb Rating: %s", selected_movie.rating.c_str());
-                ImGui::Text("Votes: %s", selected_movie.votes.c_str());
-                if (!selected_movie.genres.empty()) {
+                ImGui::Text("Title: %s", details->title.c_str());
+                std::string_view director = details->director != 0 ? Interned(details->director) : std::string_view("N/A");
+                ImGui::Text("Year: %s", YearText(*details).c_str());
+                ImGui::Text("Director: %.*s", (int)director.size(), director.data());
+                if (details->runtime_minutes != 0) ImGui::Text("Runtime: %d min", details->runtime_minutes);
+                else ImGui::Text("Runtime: N/A");
+                if (details->rating_tenths != 0) ImGui::Text("IMDb Rating: %.1f", details->rating_tenths / 10.0f);
+                else ImGui::Text("IMDb Rating: N/A");
+                if (details->votes != 0) ImGui::Text("Votes: %s", VotesText(details->votes).c_str());
+                else ImGui::Text("Votes: N/A");
+                if (details->genre_count > 0) {
                     ImGui::Text("Genres:");
-                    for (const auto& genre : selected_movie.genres) {
-                        ImGui::BulletText("%s", genre.c_str());
+                    for (int g = 0; g < details->genre_count; ++g) {
+                        std::string_view genre = Interned(details->genres[g]);
+                        ImGui::BulletText("%.*s", (int)genre.size(), genre.data());
                     }
                 }
-                if (!selected_movie.cast.empty()) {
+                if (details->cast_count > 0) {
                     ImGui::Text("Cast:");
-                    for (const auto& actor : selected_movie.cast) {
-                        ImGui::BulletText("%s", actor.c_str());
+                    for (int c = 0; c < details->cast_count; ++c) {
+                        std::string_view actor = Interned(details->cast[c]);
+                        ImGui::BulletText("%.*s", (int)actor.size(), actor.data());
                     }
                 }
             }
@@ -1029,9 +2070,9 @@ int main() {
             ImGui::Spacing();
      
            // Movie Poster
-            float image_width = 200;
-            float image_height = 300;
-            DisplayMoviePoster(selected_movie.poster_url, image_width, image_height);
+            float image_width = DETAIL_POSTER_WIDTH;
+            float image_height = DETAIL_POSTER_HEIGHT;
+            DisplayMoviePoster(details->poster_url, image_width, image_height);
             ImGui::Spacing();
 
             // Add to watch list button
@@ -1041,16 +2082,7 @@ int main() {
                     ImGui::OpenPopup("LoginRequiredPopup");
                 }
                 else {
-                    if (!IsInWatchList(selected_movie.id)) {
-                        AddToWatchList(selected_movie);
-                        selected_movie.in_watch_list = true;
-                        // Update the movie in movie_list if it exists there
-                        auto it = std::find_if(movie_list.begin(), movie_list.end(),
-                            [&](const Movie& m) { return m.id == selected_movie.id; });
-                        if (it != movie_list.end()) {
-                            it->in_watch_list = true;
-                        }
-                    }
+                    AddToWatchList(selected_movie);
                     show_not_in_list_message = false;
                 }
             }
@@ -1058,42 +2090,46 @@ int main() {
             ImGui::SameLine();
 
             if (ImGui::Button("Remove from Watch List")) {
-                if (current_selected_list != SelectedList::None && selected_movie_index != -1 && IsInWatchList(selected_movie.id)) {
-                    auto [removed, new_index] = RemoveFromWatchList(selected_movie.id);
+                if (current_selected_list != SelectedList::None && selected_movie_index != -1 && IsInWatchList(selected_movie.key())) {
+                    int position = current_selected_list == SelectedList::WatchList
+                        ? DisplayPosition(SortedOrder(watch_list_order, watch_list.load(), watch_list_sort), selected_movie_index)
+                        : -1;
+                    bool removed = RemoveFromWatchList(selected_movie.key()).first;
                     if (removed) {
                         ImGui::OpenPopup("RemovedFromWatchList");
 
                         // If we're viewing the watch list, update the selection
                         if (current_selected_list == SelectedList::WatchList) {
-                            if (watch_list.empty()) {
+                            std::shared_ptr<const MovieRows> watched = watch_list.load();
+                            if (watched->empty()) {
                                 current_selected_list = SelectedList::None;
                                 selected_movie_index = -1;
-                                selected_movie = Movie();
+                                selected_movie = MovieHandle();
                                 image_url.clear();
                             }
                             else {
-                                selected_movie_index = new_index;
-                                selected_movie = watch_list[selected_movie_index];
-                                image_url = selected_movie.poster_url;
+                                // the row now shown where the removed one was
+                                SortedView view = SortedOrder(watch_list_order, watched, watch_list_sort);
+                                selected_movie_index = DisplayedRow(view, std::clamp(position, 0, (int)view.order->size() - 1));
+                                selected_movie = (*watched)[selected_movie_index];
+                                std::shared_ptr<const Movie> next = selected_movie.get();
+                                image_url = next->poster_url;
 
                                 // Fetch detailed movie info for the newly selected movie
-                                fetch_in_progress.store(true);
-                                if (fetch_thread.joinable()) {
-                                    fetch_thread.join();
+                                if (next->details_loaded) {
+                                    if (!image_url.empty()) QueuePosterDownload(DetailPosterUrl(image_url));
+                                }
+                                else {
+                                    RequestMovieDetails(selected_movie);
                                 }
-                                fetch_thread = std::thread(FetchMovieInfoThread, selected_movie, selected_movie_index);
                             }
                         }
-                        else {
-                            // If we're in the search results, just update the status
-                            selected_movie.in_watch_list = false;
-                        }
                     }
                     else {
                         ImGui::OpenPopup("RemoveFromWatchListFailed");
                     }
                 }
-                else if (!IsInWatchList(selected_movie.id)) {
+                else if (!IsInWatchList(selected_movie.key())) {
                     ImGui::OpenPopup("MovieNotInWatchList");
                 }
                 else {
@@ -1179,7 +2215,7 @@ int main() {
 
             // Messages for watch list status
             ImGui::BeginGroup();
-            bool in_watch_list = IsInWatchList(selected_movie.id);       
+            bool in_watch_list = IsInWatchList(selected_movie.key());       
             if (in_watch_list) {
                 ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Movie is in watch list");
             }
@@ -1215,148 +2251,117 @@ int main() {
 
         ImGui::SameLine();
         if (ImGui::Button("Search") || triggerSearch) {
-            if (fetcher_thread.joinable()) {
-                fetcher_thread.join();
-            }
-            movie_list.clear();
-            selected_movie = Movie();
+            StartSearchSession();
+            selected_movie = MovieHandle();
             image_url.clear();
             movie_not_found = false;
             connection_error = false;
             selected_movie_index = -1;
             search_in_progress.store(true);
-            movie_queue.clear();
-          
+            unsigned int generation;
+            {
+                std::lock_guard<InstrumentedMutex> lock(search_mtx);
+                movie_queue.clear();
+                CancelStalePosterDownloads();
+                generation = search_generation.load();
+            }
+
             // Trigger fetching movie list based on title and use year as a filter
-            fetcher_thread = std::thread([&]() {
-                FetchMovieList(title_input, year_input);
-                });
+            Spawn(RunSearch(title_input, year_input, generation));
         }
 
         // Process movies from the queue
         if (search_in_progress.load()) {
-            Movie movie;
-            while (movie_queue.pop(movie)) {
-                movie_list.push_back(movie);
+            // take whatever arrived since the last frame; the search is done once the fetcher
+            // finished before this drain and the drain emptied the queue
+            bool fetch_finished = movie_queue.is_finished();
+            MovieRows arrived;
+            std::size_t ingested = movie_queue.drain_into(arrived, MAX_MOVIES_PER_FRAME);
+            if (ingested > 0) {
+                movie_list.update([&](MovieRows& movies) {
+                    movies.insert(movies.end(), std::make_move_iterator(arrived.begin()), std::make_move_iterator(arrived.end()));
+                });
             }
-            if (movie_queue.is_finished()) {
+            std::shared_ptr<const MovieRows> results = movie_list.load();
+            if (fetch_finished && ingested < MAX_MOVIES_PER_FRAME && movie_queue.empty()) {
                 search_in_progress.store(false);
-                if (!movie_list.empty()) {
+                if (!results->empty()) {
                     first_run = false;
                 }
-                if (movie_list.empty()) {
+                if (results->empty()) {
                     movie_not_found = true;
                 }
-                else if (movie_list.size() == 1) {
+                else if (results->size() == 1) {
                     // Automatically select and display the movie if it's the only one in the list
                     selected_movie_index = 0;
-                    selected_movie = movie_list[0];
+                    current_selected_list = SelectedList::SearchResults;
+                    selected_movie = (*results)[0];
                     image_url.clear();
 
                     // Fetch detailed movie info
-                    bool fetch_success = FetchMovieInfo(selected_movie);
-                    if (fetch_success) {
-                        // Update the movie in the list with the fetched details
-                        movie_list[selected_movie_index] = selected_movie;
-
-                        // Load the image if it's not already loaded
-                        if (!image_url.empty()) {
-                            std::unique_lock<std::mutex> lock(mtx);
-                            if (textureMap.find(image_url) == textureMap.end()) {
-                                image_queue.push(image_url);
-                                cv.notify_one();
-                            }
-                        }
-                    }
-                    else {
-                        std::cerr << "Failed to fetch movie details. Please try again." << std::endl;
-                    }
+                    RequestMovieDetails(selected_movie);
                 }
             }
         }
 
-        // Display search results or messages
-        if (search_in_progress.load()) {
+        // Display search results or messages, from one version of the list for the whole frame
+        std::shared_ptr<const MovieRows> results = movie_list.load();
+        if (search_in_progress.load() && results->empty()) {
             ImGui::Text("Searching...");
         }
-        else if (!movie_list.empty()) {
-            ImGui::Text("Search Results:");
+        else if (!results->empty()) {
+            if (search_in_progress.load()) {
+                ImGui::Text("Searching... %d results so far", (int)results->size());
+            }
+            else {
+                ImGui::Text("Search Results:");
+            }
             // Create a child window for the scrollable list
             ImGui::BeginChild("SearchResults", ImVec2(0, display_h * 0.3f), true);
-            if (ImGui::BeginTable("SearchResultsTable", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp)) {
-                ImGui::TableSetupColumn("Title", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_WidthStretch, 0.7f);
-                ImGui::TableSetupColumn("Year", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_WidthStretch, 0.3f);
-                ImGui::TableHeadersRow();
+            if (ImGui::BeginTable("SearchResultsTable", MOVIE_TABLE_COLUMNS, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp)) {
+                SetupMovieTableColumns();
 
                 if (ImGui::TableGetSortSpecs()->SpecsDirty) {
                     ImGuiTableSortSpecs* sorts_specs = ImGui::TableGetSortSpecs();
-                    if (sorts_specs->Specs->ColumnIndex == 0) {
-                        sort_movie_list_by_year = false;
-                        sort_movie_list_ascending = sorts_specs->Specs->SortDirection == ImGuiSortDirection_Ascending;
-                    }
-                    else {
-                        sort_movie_list_by_year = true;
-                        sort_movie_list_ascending = sorts_specs->Specs->SortDirection == ImGuiSortDirection_Ascending;
-                    }
-                    sortMovieList();
-                    sorts_specs->SpecsDirty = false;
+                    movie_list_sort = SortSpecFromTable(sorts_specs);
+                    sorts_specs->SpecsDirty = false; // the rows are drawn through a cached permutation, nothing moves
                 }
 
-                for (int i = 0; i < movie_list.size(); ++i) {
-                    ImGui::TableNextRow();
-                    ImGui::TableSetColumnIndex(0);
-                    std::string selectable_label = movie_list[i].title + "##" + std::to_string(i);
-                    if (ImGui::Selectable(selectable_label.c_str(),
-                        current_selected_list == SelectedList::SearchResults && selected_movie_index == i,
-                        ImGuiSelectableFlags_SpanAllColumns)) {
-                        try {
-                            first_run = false;
-                            selected_movie_index = i;
-                            current_selected_list = SelectedList::SearchResults;
-                            selected_movie = movie_list[i];
-                            image_url = selected_movie.poster_url;
-                            show_not_in_list_message = false;
-
-                            // Fetch detailed movie info when selected
-                            fetch_in_progress.store(true);
-                            if (fetch_thread.joinable()) {
-                                fetch_thread.join();
+                SortedView view = SortedOrder(movie_list_order, results, movie_list_sort);
+                ImGuiListClipper clipper; // only the visible rows are laid out
+                clipper.Begin((int)view.order->size());
+                while (clipper.Step()) {
+                    for (int position = clipper.DisplayStart; position < clipper.DisplayEnd; ++position) {
+                        int i = DisplayedRow(view, position);
+                        std::shared_ptr<const Movie> row = movie_list_order.records[i];
+                        ImGui::TableNextRow();
+                        ImGui::TableSetColumnIndex(0);
+                        std::string selectable_label = row->title + "##" + std::to_string(i);
+                        if (ImGui::Selectable(selectable_label.c_str(),
+                            current_selected_list == SelectedList::SearchResults && selected_movie_index == i,
+                            ImGuiSelectableFlags_SpanAllColumns)) {
+                            try {
+                                first_run = false;
+                                selected_movie_index = i;
+                                current_selected_list = SelectedList::SearchResults;
+                                selected_movie = (*results)[i];
+                                image_url = row->poster_url;
+                                show_not_in_list_message = false;
+
+                                // Fetch detailed movie info when selected
+                                RequestMovieDetails(selected_movie);
+                            }
+                            catch (const std::exception& e) {
+                                logError("Exception in movie selection: " + std::string(e.what()));
                             }
-                            fetch_thread = std::thread([i]() {
-                                try {
-                                    Movie temp_movie = movie_list[i];
-                                    bool fetch_success = FetchMovieInfo(temp_movie);
-                                    if (fetch_success) {
-                                        std::lock_guard<std::mutex> lock(mtx);
-                                        movie_list[i] = temp_movie;
-                                        if (selected_movie_index == i && current_selected_list == SelectedList::SearchResults) {
-                                            selected_movie = temp_movie;
-                                            selected_movie.in_watch_list = IsInWatchList(selected_movie.id);
-                                            // Load the image if it's not already loaded
-                                            if (!selected_movie.poster_url.empty()) {
-                                                if (textureMap.find(selected_movie.poster_url) == textureMap.end()) {
-                                                    image_queue.push(selected_movie.poster_url);
-                                                    cv.notify_one();
-                                                }
-                                            }
-                                        }
-                                    }
-                                    else {
-                                        logError("Failed to fetch movie info for: " + temp_movie.title);
-                                    }
-                                }
-                                catch (const std::exception& e) {
-                                    logError("Exception in fetch thread: " + std::string(e.what()));
-                                }
-                                fetch_in_progress.store(false);
-                                });
                         }
-                        catch (const std::exception& e) {
-                            logError("Exception in movie selection: " + std::string(e.what()));
+                        if (ImGui::IsItemHovered() && !row->poster_url.empty() && row->poster_url != "N/A") {
+                            ImGui::BeginTooltip();
+                            DisplayMoviePoster(row->poster_url, 64, 96);
+                            ImGui::EndTooltip();
                         }
+                        MovieTableCells(*row);
                     }
-                    ImGui::TableSetColumnIndex(1);
-                    ImGui::Text("%s", movie_list[i].release_year.c_str());
                 }
                 ImGui::EndTable();
             }
@@ -1380,63 +2385,66 @@ int main() {
         if (current_user.empty()) {
             ImGui::TextColored(ImVec4(0.0f, 1.0f, 1.0f, 1.0f), "Log in to see your watch list");
         }
-        else if (watch_list.empty()) {
+        else if (watch_list.load()->empty()) {
             ImGui::TextColored(ImVec4(0.0f, 1.0f, 1.0f, 1.0f), "No movies in your watch list");
         }
         else {
+            if (IsWatchListWarming()) {
+                int done = watch_list_warm_done.load(), total = watch_list_warm_total.load();
+                std::string progress = "Loading details " + std::to_string(done) + "/" + std::to_string(total);
+                ImGui::ProgressBar(total > 0 ? (float)done / total : 0.0f, ImVec2(-1.0f, 0.0f), progress.c_str());
+            }
             // Create a child window for the scrollable watch list
             ImGui::BeginChild("WatchList", ImVec2(0, display_h * 0.3f), true);
-            if (ImGui::BeginTable("WatchListTable", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp)) {
-                ImGui::TableSetupColumn("Title", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_WidthStretch, 0.7f);
-                ImGui::TableSetupColumn("Year", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_WidthStretch, 0.3f);
-                ImGui::TableHeadersRow();
+            if (ImGui::BeginTable("WatchListTable", MOVIE_TABLE_COLUMNS, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp)) {
+                SetupMovieTableColumns();
 
                 if (ImGui::TableGetSortSpecs()->SpecsDirty) {
                     ImGuiTableSortSpecs* sorts_specs = ImGui::TableGetSortSpecs();
-                    if (sorts_specs->Specs->ColumnIndex == 0) {
-                        sort_watch_list_by_year = false;
-                        sort_watch_list_ascending = sorts_specs->Specs->SortDirection == ImGuiSortDirection_Ascending;
-                    }
-                    else {
-                        sort_watch_list_by_year = true;
-                        sort_watch_list_ascending = sorts_specs->Specs->SortDirection == ImGuiSortDirection_Ascending;
-                    }
-                    sortWatchList();
+                    watch_list_sort = SortSpecFromTable(sorts_specs);
                     sorts_specs->SpecsDirty = false;
                 }
 
-                for (int i = 0; i < watch_list.size(); ++i) {
-                    ImGui::TableNextRow();
-                    ImGui::TableSetColumnIndex(0);
-                    std::string selectable_label = watch_list[i].title + "##" + watch_list[i].id;
-                    if (ImGui::Selectable(selectable_label.c_str(),
-                        current_selected_list == SelectedList::WatchList && selected_movie_index == i,
-                        ImGuiSelectableFlags_SpanAllColumns)) {
-                        first_run = false;
-                        selected_movie_index = i;
-                        current_selected_list = SelectedList::WatchList;
-                        selected_movie = watch_list[i];
-                        image_url = selected_movie.poster_url;
-                        show_not_in_list_message = false;
-
-                        // Fetch detailed movie info when selected
-                        bool fetch_success = FetchMovieInfo(selected_movie);
-                        if (fetch_success) {
-                            // Load the image if it's not already loaded
-                            if (!image_url.empty()) {
-                                std::unique_lock<std::mutex> lock(mtx);
-                                if (textureMap.find(image_url) == textureMap.end()) {
-                                    image_queue.push(image_url);
-                                    cv.notify_one();
+                std::shared_ptr<const MovieRows> watched = watch_list.load();
+
+                SortedView view = SortedOrder(watch_list_order, watched, watch_list_sort);
+                ImGuiListClipper clipper;
+                clipper.Begin((int)view.order->size());
+                while (clipper.Step()) {
+                    for (int position = clipper.DisplayStart; position < clipper.DisplayEnd; ++position) {
+                        int i = DisplayedRow(view, position);
+                        std::shared_ptr<const Movie> row = watch_list_order.records[i];
+                        ImGui::TableNextRow();
+                        ImGui::TableSetColumnIndex(0);
+                        std::string selectable_label = row->title + "##" + row->id;
+                        if (ImGui::Selectable(selectable_label.c_str(),
+                            current_selected_list == SelectedList::WatchList && selected_movie_index == i,
+                            ImGuiSelectableFlags_SpanAllColumns)) {
+                            first_run = false;
+                            selected_movie_index = i;
+                            current_selected_list = SelectedList::WatchList;
+                            selected_movie = (*watched)[i];
+                            image_url = row->poster_url;
+                            show_not_in_list_message = false;
+
+                            // Fetch detailed movie info when selected, unless the login warm up already did
+                            if (row->details_loaded) {
+                                // Load the image if it's not already loaded
+                                if (!image_url.empty()) {
+                                    QueuePosterDownload(DetailPosterUrl(image_url));
                                 }
                             }
+                            else {
+                                RequestMovieDetails(selected_movie);
+                            }
                         }
-                        else {
-                            ImGui::Text("Failed to fetch movie details. Please try again.");
+                        if (ImGui::IsItemHovered() && !row->poster_url.empty() && row->poster_url != "N/A") {
+                            ImGui::BeginTooltip();
+                            DisplayMoviePoster(row->poster_url, 64, 96);
+                            ImGui::EndTooltip();
                         }
+                        MovieTableCells(*row);
                     }
-                    ImGui::TableSetColumnIndex(1);
-                    ImGui::Text("%s", watch_list[i].release_year.c_str());
                 }
                 ImGui::EndTable();
             }
@@ -1465,20 +2473,36 @@ int main() {
         });
 
     // Cleanup
-    image_thread_running = false;  // Signal the image loading thread to stop
-    cv.notify_all();  // Wake up the image loading thread if it's waiting
-    if (image_thread.joinable()) {
-        image_thread.join();
-    }
-    if (fetcher_thread.joinable()) {
-        fetcher_thread.join();
+    image_thread_running = false;  // Signal the image threads to stop
+    image_queue.stop();  // Wake up the download threads if they're waiting
+    download_queue.setFinished();
+    upload_queue.setFinished();
+    for (auto& thread : image_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
     }
-    if (fetch_thread.joinable()) {
-        fetch_thread.join();
+    DecodedImage pending;
+    while (upload_queue.try_pop(pending)) {
+        FreeDecodedImage(pending.data);
+        PixelArenaFree(pending.mip_data);
     }
+    StopWatchListWarmup();
+    FlushWatchList();
+    task_scheduler.shutdown();
 
     // Clear any remaining items in the queue
     movie_queue.clear();
+    PrintPipelineStatistics();
+    PrintStringPoolStatistics();
+    PrintMovieStoreStatistics();
+    PrintUserStoreStatistics();
+    PrintSortStatistics();
+    PrintMemoryStatistics();
+    PrintHttpStatistics();
+    PrintSchedulerStatistics();
+    PrintDetailChainStatistics();
+    PrintContentionStatistics();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -0,0 +1,90 @@
+//
+// Created by user on 10/18/2026.
+//
+// stb_image with its SIMD JPEG kernels, and the runtime choice between it and the scalar build in
+// image_decode_scalar.cpp.
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#include <pixel_arena.h>
+
+// decoded pixels (and stb's scratch buffers) live in the recycling pixel arena
+#define STBI_MALLOC(size) PixelArenaMalloc(size)
+#define STBI_REALLOC_SIZED(ptr, old_size, new_size) PixelArenaRealloc(ptr, old_size, new_size)
+#define STBI_FREE(ptr) PixelArenaFree(ptr)
+
+// stb_image picks SSE2 up by itself on x86/x64, NEON has to be asked for explicitly
+#if (defined(__ARM_NEON) || defined(_M_ARM64)) && !defined(STBI_NEON)
+#define STBI_NEON
+#endif
+
+#include <stb_image.h>
+#include <image_decode.h>
+
+#if defined(STBI_SSE2)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+
+bool CpuHasSimdKernels() {
+#if defined(STBI_SSE2)
+    unsigned int edx = 0;
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    edx = (unsigned int)info[3];
+#else
+    unsigned int eax, ebx, ecx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+#endif
+    return (edx >> 26) & 1; // SSE2
+#elif defined(STBI_NEON)
+    return true; // part of every ARMv8 core
+#else
+    return false; // stb turned its kernels off for this target
+#endif
+}
+
+} // namespace
+
+bool SimdDecodeAvailable() {
+    static const bool available = CpuHasSimdKernels();
+    return available;
+}
+
+DecodePath ActiveDecodePath() {
+    return SimdDecodeAvailable() ? DecodePath::Simd : DecodePath::Scalar;
+}
+
+const char* DecodePathName(DecodePath path) {
+#if defined(STBI_NEON)
+    return path == DecodePath::Simd ? "NEON" : "scalar";
+#else
+    return path == DecodePath::Simd ? "SSE2" : "scalar";
+#endif
+}
+
+unsigned char* DecodeImage(const unsigned char* data, int size, int* width, int* height, int* channels,
+    int desired_channels, DecodePath path) {
+    if (path == DecodePath::Scalar) return DecodeImageScalar(data, size, width, height, channels, desired_channels);
+    return stbi_load_from_memory(data, size, width, height, channels, desired_channels);
+}
+
+unsigned char* DecodeImageFile(const char* filename, int* width, int* height, int* channels,
+    int desired_channels, DecodePath path) {
+    if (path == DecodePath::Scalar) return DecodeImageFileScalar(filename, width, height, channels, desired_channels);
+    return stbi_load(filename, width, height, channels, desired_channels);
+}
+
+const char* DecodeFailureReason(DecodePath path) {
+    return path == DecodePath::Scalar ? DecodeFailureReasonScalar() : stbi_failure_reason();
+}
+
+void FreeDecodedImage(void* pixels) {
+    stbi_image_free(pixels);
+}
@@ -0,0 +1,30 @@
+//
+// Created by user on 10/18/2026.
+//
+// stb_image without its SIMD kernels, the fallback of image_decode.h for CPUs without SSE2 or NEON.
+// Everything of stb stays static to this file so it does not clash with the SIMD build.
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_STATIC
+#define STBI_NO_SIMD
+
+#include <pixel_arena.h>
+
+#define STBI_MALLOC(size) PixelArenaMalloc(size)
+#define STBI_REALLOC_SIZED(ptr, old_size, new_size) PixelArenaRealloc(ptr, old_size, new_size)
+#define STBI_FREE(ptr) PixelArenaFree(ptr)
+
+#include <stb_image.h>
+#include <image_decode.h>
+
+unsigned char* DecodeImageScalar(const unsigned char* data, int size, int* width, int* height, int* channels, int desired_channels) {
+    return stbi_load_from_memory(data, size, width, height, channels, desired_channels);
+}
+
+unsigned char* DecodeImageFileScalar(const char* filename, int* width, int* height, int* channels, int desired_channels) {
+    return stbi_load(filename, width, height, channels, desired_channels);
+}
+
+const char* DecodeFailureReasonScalar() {
+    return stbi_failure_reason();
+}
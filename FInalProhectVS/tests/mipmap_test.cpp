@@ -0,0 +1,103 @@
+//
+// Created by user on 10/18/2026.
+//
+// Checks that DownsampleRgba's SSE2 loop produces the same bytes as the scalar (a + b + c + d + 2) / 4
+// box filter, so mip levels do not depend on which path ran.
+// Build and run from this directory: g++ -std=c++20 -O2 -I../include mipmap_test.cpp && ./a.out
+
+#include <mipmap.h>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// the scalar tail of DownsampleRgba applied to every pixel
+std::vector<unsigned char> ScalarDownsample(const std::vector<unsigned char>& src, int src_width, int src_height) {
+    int dst_width = std::max(1, src_width / 2);
+    int dst_height = std::max(1, src_height / 2);
+    std::vector<unsigned char> dst(static_cast<std::size_t>(dst_width) * dst_height * 4);
+    for (int y = 0; y < dst_height; ++y) {
+        const unsigned char* row0 = src.data() + static_cast<std::size_t>(std::min(2 * y, src_height - 1)) * src_width * 4;
+        const unsigned char* row1 = src.data() + static_cast<std::size_t>(std::min(2 * y + 1, src_height - 1)) * src_width * 4;
+        for (int x = 0; x < dst_width; ++x) {
+            for (int c = 0; c < 4; ++c) {
+                int value = src_width > 1
+                    ? (row0[x * 8 + c] + row0[x * 8 + 4 + c] + row1[x * 8 + c] + row1[x * 8 + 4 + c] + 2) / 4
+                    : (row0[c] + row1[c] + 1) / 2;
+                dst[(static_cast<std::size_t>(y) * dst_width + x) * 4 + c] = static_cast<unsigned char>(value);
+            }
+        }
+    }
+    return dst;
+}
+
+bool MatchesScalar(const std::vector<unsigned char>& src, int width, int height) {
+    std::vector<unsigned char> expected = ScalarDownsample(src, width, height);
+    std::vector<unsigned char> actual(expected.size());
+    DownsampleRgba(src.data(), width, height, actual.data());
+    return actual == expected;
+}
+
+int main() {
+#ifdef MIPMAP_SSE2
+    std::cout << "mipmap_test: SSE2 path" << std::endl;
+#else
+    std::cout << "mipmap_test: scalar path only" << std::endl;
+#endif
+    std::mt19937 random(7);
+
+    // sums that are 1 or 3 mod 4 are where chained byte averages round up and the exact filter does not
+    std::vector<unsigned char> ones = { 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0 };
+    ones.resize(16 * 4 * 2);
+    for (std::size_t i = 16; i < ones.size(); ++i) ones[i] = (i % 5 == 0) ? 3 : 0;
+    Check(MatchesScalar(ones, 16, 2), "rounding of small sums");
+
+    // every width around the 4 pixel SIMD step, odd sizes and 1 pixel wide or tall images
+    const int sizes[][2] = { { 2, 2 }, { 7, 3 }, { 8, 8 }, { 9, 9 }, { 15, 2 }, { 16, 16 }, { 17, 5 }, { 1, 9 }, { 33, 1 }, { 300, 450 } };
+    for (const auto& size : sizes) {
+        std::vector<unsigned char> src(static_cast<std::size_t>(size[0]) * size[1] * 4);
+        for (int round = 0; round < 20; ++round) {
+            for (auto& byte : src) byte = static_cast<unsigned char>(random() & 0xFF);
+            if (!MatchesScalar(src, size[0], size[1])) {
+                std::cerr << size[0] << "x" << size[1] << ": ";
+                Check(false, "random image matches the scalar filter");
+                break;
+            }
+        }
+    }
+
+    // whole chains: level sizes follow OpenGL and every level is the filtered previous one
+    int width = 37, height = 20;
+    std::vector<unsigned char> base(static_cast<std::size_t>(width) * height * 4);
+    for (auto& byte : base) byte = static_cast<unsigned char>(random() & 0xFF);
+    std::vector<unsigned char> chain(MipChainSize(width, height));
+    BuildMipChain(base.data(), width, height, chain.data());
+    Check(MipLevelCount(width, height) == 6, "37x20 has 6 levels");
+    std::vector<unsigned char> level = base;
+    std::size_t offset = 0;
+    while (width > 1 || height > 1) {
+        level = ScalarDownsample(level, width, height);
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        if (!std::equal(level.begin(), level.end(), chain.begin() + offset)) {
+            Check(false, "chain level matches the scalar filter");
+            break;
+        }
+        offset += level.size();
+    }
+    Check(offset == chain.size(), "MipChainSize covers every level");
+
+    if (failures == 0) {
+        std::cout << "mipmap_test: all checks passed" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
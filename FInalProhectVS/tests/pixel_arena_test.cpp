@@ -0,0 +1,115 @@
+//
+// Created by user on 10/18/2026.
+//
+// Counts heap allocations around the poster memory paths: the bundled AGM.jpg goes through the real
+// stb_image build (image_decode.cpp, both the SIMD and the scalar path), its mip chain through the
+// pixel arena and its BC1 blocks through a ByteBufferPool. Once the first pass warmed everything up,
+// decoding it again must not touch the heap.
+// Build and run from this directory: g++ -std=c++20 -O2 -I../include -I../include/stb pixel_arena_test.cpp ../src/image_decode.cpp ../src/image_decode_scalar.cpp && ./a.out
+
+#include <pixel_arena.h>
+#include <image_decode.h>
+#include <mipmap.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <vector>
+
+std::atomic<unsigned long long> heap_allocations(0); // operator new and malloc through the arena
+
+void* operator new(std::size_t size) {
+    heap_allocations++;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// one poster through the pipeline: body download, decode, mip chain, BC1 blocks, upload; false when
+// the image did not decode
+bool DecodePoster(ByteBufferPool& bodies, ByteBufferPool& blocks, const std::vector<unsigned char>& jpeg, DecodePath path) {
+    std::vector<unsigned char> body = bodies.acquire();
+    body.assign(jpeg.begin(), jpeg.end());
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = DecodeImage(body.data(), (int)body.size(), &width, &height, &channels, 4, path);
+    bodies.release(std::move(body));
+    if (pixels == nullptr) return false;
+    unsigned char* mips = static_cast<unsigned char*>(PixelArenaMalloc(MipChainSize(width, height)));
+    BuildMipChain(pixels, width, height, mips);
+    std::vector<unsigned char> compressed = blocks.acquire();
+    compressed.resize((std::size_t)width * height / 2 * 4 / 3 + 64); // about a BC1 mip chain
+    FreeDecodedImage(pixels);
+    PixelArenaFree(mips);
+    blocks.release(std::move(compressed));
+    return true;
+}
+
+int main() {
+    std::ifstream file("../images/AGM.jpg", std::ios::binary);
+    std::vector<unsigned char> jpeg((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (jpeg.empty()) {
+        std::cerr << "FAILED: ../images/AGM.jpg could not be read, run from the tests directory" << std::endl;
+        return 1;
+    }
+
+    ByteBufferPool bodies;
+    ByteBufferPool blocks;
+    std::vector<DecodePath> paths = { DecodePath::Scalar };
+    if (SimdDecodeAvailable()) paths.push_back(DecodePath::Simd);
+
+    for (DecodePath path : paths) {
+        PixelArena::Statistics before = PixelArena::instance().statistics();
+        Check(DecodePoster(bodies, blocks, jpeg, path), "AGM.jpg decodes");
+        unsigned long long warm_heap = heap_allocations.load();
+        PixelArena::Statistics warm = PixelArena::instance().statistics();
+
+        const int decodes = 20;
+        bool decoded = true;
+        for (int i = 0; i < decodes; ++i) {
+            decoded = DecodePoster(bodies, blocks, jpeg, path) && decoded;
+        }
+        PixelArena::Statistics after = PixelArena::instance().statistics();
+        Check(decoded, "AGM.jpg decodes every time");
+
+        std::cout << DecodePathName(path) << ": first decode " << warm.heap_allocations - before.heap_allocations
+            << " arena heap misses; " << decodes << " more decodes " << after.allocations - warm.allocations
+            << " arena allocations, " << after.heap_allocations - warm.heap_allocations << " arena heap misses, "
+            << heap_allocations.load() - warm_heap << " operator new calls" << std::endl;
+        Check(after.allocations > warm.allocations, "stb allocates through the arena");
+        Check(after.heap_allocations == warm.heap_allocations, "no arena heap misses once warm");
+        Check(heap_allocations.load() == warm_heap, "no operator new once the buffer pools are warm");
+    }
+
+    // a bigger body than any before grows its buffer once, the pool keeps the bigger capacity
+    auto grow = [&bodies] {
+        std::vector<unsigned char> body = bodies.acquire();
+        body.resize(4 * 1024 * 1024);
+        bodies.release(std::move(body));
+    };
+    grow();
+    unsigned long long grown_heap = heap_allocations.load();
+    grow();
+    Check(heap_allocations.load() == grown_heap, "grown buffers are reused");
+
+    if (failures == 0) {
+        std::cout << "pixel_arena_test: all checks passed" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
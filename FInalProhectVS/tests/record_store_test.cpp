@@ -0,0 +1,78 @@
+//
+// Created by user on 10/18/2026.
+//
+// Checks that RecordStore frees a record with its last handle: copies, finds and the change log keep
+// it alive, a later insert of a freed key starts over, and handles racing on the same keys from several
+// threads never see a freed slot.
+// Build and run from this directory: g++ -std=c++20 -O2 -pthread -I../include record_store_test.cpp && ./a.out
+
+#include <record_store.h>
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Record {
+    int value = 0;
+};
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+int main() {
+    RecordStore<Record> store;
+    {
+        auto first = store.insert("a", { 1 });
+        auto copy = first;
+        auto found = store.find("a");
+        Check(store.statistics().records == 1, "copies and finds share one record");
+        first = {};
+        copy = {};
+        Check(store.statistics().records == 1, "the last handle keeps the record");
+        Check(store.find("a").get()->value == 1, "the record is still readable");
+    }
+    Check(store.statistics().records == 0, "the record goes with its last handle");
+    Check(!store.find("a"), "a freed key is not found");
+    Check(store.insert("a", { 2 }).get()->value == 2, "inserting a freed key starts over");
+
+    auto changed = store.insert("b", { 1 });
+    unsigned long long version = store.version();
+    store.publish(changed, { 2 });
+    changed = {};
+    std::vector<RecordStore<Record>::Handle> since;
+    Check(store.changed_since(version, since) && since.size() == 1 && since[0].get()->value == 2,
+        "the change log keeps replaced records until they age out");
+    since.clear();
+
+    // threads insert, find and drop handles of the same few keys, so last releases race with lookups
+    std::vector<std::thread> threads;
+    std::vector<int> misses(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&store, &misses, t] {
+            for (int i = 0; i < 100000; ++i) {
+                auto handle = store.insert("k" + std::to_string(i % 50), { i });
+                auto found = store.find(handle.key());
+                if (!found || found != handle) misses[t]++;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    int missed = 0;
+    for (int count : misses) missed += count;
+    Check(missed == 0, "a live handle's key is always found");
+    RecordStore<Record>::Statistics stats = store.statistics();
+    std::cout << stats.inserts << " inserts, " << stats.released << " records released, " << stats.records << " alive" << std::endl;
+    Check(stats.records == 1, "only the record held by the change log is left");
+
+    if (failures == 0) {
+        std::cout << "record_store_test: all checks passed" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+//
+// Created by user on 10/18/2026.
+//
+// Checks the BC1 encoder in texture_compression.h against its decoder.
+// Build and run from this directory: g++ -std=c++20 -O2 -I../include texture_compression_test.cpp && ./a.out
+
+#include <texture_compression.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+int MaxError(const unsigned char source[16][3], const unsigned char decoded[16][3]) {
+    int error = 0;
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            error = std::max(error, std::abs(source[i][c] - decoded[i][c]));
+        }
+    }
+    return error;
+}
+
+// returns the largest per channel error, squared_error / variance receive the summed squared error
+// against the source and against the source's mean color
+int RoundTrip(const unsigned char source[16][3], double* squared_error = nullptr, double* variance = nullptr) {
+    unsigned char encoded[8];
+    unsigned char decoded[16][3];
+    CompressBc1Block(source, encoded);
+    DecompressBc1Block(encoded, decoded);
+    if (squared_error != nullptr && variance != nullptr) {
+        double mean[3] = { 0, 0, 0 };
+        for (int i = 0; i < 16; ++i) {
+            for (int c = 0; c < 3; ++c) mean[c] += source[i][c] / 16.0;
+        }
+        *squared_error = *variance = 0;
+        for (int i = 0; i < 16; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                double d = source[i][c] - decoded[i][c];
+                double m = source[i][c] - mean[c];
+                *squared_error += d * d;
+                *variance += m * m;
+            }
+        }
+    }
+    return MaxError(source, decoded);
+}
+
+int main() {
+    // a color RGB565 can hold exactly comes back unchanged
+    unsigned char solid[16][3];
+    for (auto& pixel : solid) {
+        pixel[0] = 255; pixel[1] = 0; pixel[2] = 132;
+    }
+    Check(RoundTrip(solid) == 0, "solid 565 color round-trips exactly");
+
+    // any other flat color is off by at most the 565 quantization step
+    for (auto& pixel : solid) {
+        pixel[0] = 100; pixel[1] = 150; pixel[2] = 200;
+    }
+    Check(RoundTrip(solid) <= 4, "solid color within 565 quantization");
+
+    // a smooth two color ramp lies on the palette line, no pixel is further than half a palette step
+    // (a third of the inset range) from its entry
+    unsigned char ramp[16][3];
+    for (int i = 0; i < 16; ++i) {
+        ramp[i][0] = (unsigned char)(i * 16);
+        ramp[i][1] = (unsigned char)(255 - i * 16);
+        ramp[i][2] = 64;
+    }
+    Check(RoundTrip(ramp) <= 36, "ramp within half a palette step");
+
+    // noise has no good two color fit, but four palette entries must still beat one flat mean color
+    std::mt19937 random(42);
+    for (int block = 0; block < 1000; ++block) {
+        unsigned char noise[16][3];
+        for (auto& pixel : noise) {
+            for (int c = 0; c < 3; ++c) pixel[c] = (unsigned char)(random() & 0xFF);
+        }
+        double squared_error, variance;
+        RoundTrip(noise, &squared_error, &variance);
+        if (squared_error >= variance) {
+            Check(false, "noise block closer than its mean color");
+            break;
+        }
+    }
+
+    // CompressBc1 writes one block per 4x4 tile, edge tiles included
+    unsigned char pixels[6 * 5 * 4] = {};
+    unsigned char out[4 * 8 + 1];
+    out[4 * 8] = 0xAB;
+    Check(Bc1Size(6, 5) == 4 * 8, "6x5 image is 2x2 blocks");
+    CompressBc1(pixels, 6, 5, 4, out);
+    Check(out[4 * 8] == 0xAB, "CompressBc1 stays inside Bc1Size");
+
+    if (failures == 0) {
+        std::cout << "texture_compression_test: all checks passed" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}